@@ -0,0 +1,40 @@
+/* This example lets the timing budget follow the target: short (fast) for
+ * a near, bright target, up to 200 ms for a far or dark one. Move your hand
+ * in front of the sensor and watch the budget change.
+ */
+#include "Adafruit_VL53L0X.h"
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X adaptive timing budget example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  // between 20 ms and 200 ms, keep the sigma estimate under 15 mm
+  lox.setAdaptiveBudget(20000, 200000, 15 * 65536);
+}
+
+void loop() {
+  uint16_t range = lox.readRange();
+
+  Serial.print(F("budget: "));
+  Serial.print(lox.getMeasurementTimingBudgetMicroSeconds() / 1000);
+  Serial.print(F(" ms, range: "));
+  if (lox.readRangeStatus() != 4) {  // phase failures have incorrect data
+    Serial.println(range);
+  } else {
+    Serial.println(F("out of range"));
+  }
+
+  delay(100);
+}
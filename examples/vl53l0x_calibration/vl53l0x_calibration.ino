@@ -0,0 +1,90 @@
+/* This example calibrates the range offset and the cover glass crosstalk.
+ * Each calibration ranges back to back and stops as soon as the result is
+ * known to within the tolerance, which takes far fewer ranges than the
+ * fixed 50 of the ST procedure on a steady target.
+ *
+ * Put a white target at OFFSET_DISTANCE_MM, send any character, then a grey
+ * target at XTALK_DISTANCE_MM and send another one. Note the results, they
+ * can be applied after begin() instead of calibrating again.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define OFFSET_DISTANCE_MM 100
+#define XTALK_DISTANCE_MM 400
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void waitForKey() {
+  while (Serial.available())
+    Serial.read();
+  while (!Serial.available())
+    delay(10);
+  while (Serial.available())
+    Serial.read();
+}
+
+void setup() {
+  int32_t offset_um;
+  float rate_mcps;
+  uint16_t samples;
+  uint32_t start;
+
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X calibration example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  Serial.println(F("White target at 100 mm, send a character"));
+  waitForKey();
+  start = millis();
+  if (lox.calibrateOffset(OFFSET_DISTANCE_MM, 0.5, &offset_um, &samples)) {
+    Serial.print(F("offset: "));
+    Serial.print(offset_um);
+    Serial.print(F(" um from "));
+    Serial.print(samples);
+    Serial.print(F(" ranges in "));
+    Serial.print(millis() - start);
+    Serial.println(F(" ms"));
+  } else {
+    Serial.print(F("offset calibration failed, status "));
+    Serial.println(lox.Status);
+  }
+
+  Serial.println(F("Grey target at 400 mm, send a character"));
+  waitForKey();
+  start = millis();
+  if (lox.calibrateXTalk(XTALK_DISTANCE_MM, 0.0005, &rate_mcps, &samples)) {
+    Serial.print(F("crosstalk: "));
+    Serial.print(rate_mcps, 5);
+    Serial.print(F(" MCPS per SPAD from "));
+    Serial.print(samples);
+    Serial.print(F(" ranges in "));
+    Serial.print(millis() - start);
+    Serial.println(F(" ms"));
+  } else {
+    Serial.print(F("crosstalk calibration failed, status "));
+    Serial.println(lox.Status);
+  }
+}
+
+void loop() {
+  VL53L0X_RangingMeasurementData_t measure;
+
+  lox.rangingTest(&measure, false);
+  if (measure.RangeStatus != 4) {  // phase failures have incorrect data
+    Serial.print(F("Distance (mm): "));
+    Serial.println(measure.RangeMilliMeter);
+  } else {
+    Serial.println(F(" out of range "));
+  }
+
+  delay(100);
+}
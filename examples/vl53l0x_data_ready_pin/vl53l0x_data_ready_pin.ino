@@ -0,0 +1,37 @@
+/* This example ranges continuously and finds out when a range is ready by
+ * reading the pin GPIO1 is wired to, instead of asking the sensor over I2C.
+ * The bus then only carries the result reads, which matters with several
+ * sensors on it. Wire GPIO1 of the breakout to DATA_READY_PIN.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define DATA_READY_PIN 6
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X data ready pin example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  // begin() leaves GPIO1 signalling new samples, active low
+  lox.setDataReadyPin(DATA_READY_PIN);
+  lox.startRangeContinuous();
+}
+
+void loop() {
+  // a digitalRead(), no I2C transfer
+  if (lox.isRangeComplete()) {
+    Serial.print(F("Distance in mm: "));
+    Serial.println(lox.readRangeResult());
+  }
+}
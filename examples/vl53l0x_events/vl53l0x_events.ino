@@ -0,0 +1,52 @@
+/* This example only wakes up the host when something enters or leaves the
+ * zone between 100 mm and 500 mm in front of the sensor. The sensor keeps
+ * ranging on its own and pulls GPIO1 low on a crossing, the sketch waits
+ * for that instead of reading every range.
+ * Connect GPIO1 of the sensor to EVENT_PIN.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define EVENT_PIN 6
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void onRangeEvent(uint16_t range_mm, Adafruit_VL53L0X::VL53L0X_Zone_t zone) {
+  if (zone == Adafruit_VL53L0X::VL53L0X_ZONE_INSIDE) {
+    Serial.print(F("occupied at "));
+  } else {
+    Serial.print(F("free at "));
+  }
+  Serial.print(range_mm);
+  Serial.println(F(" mm"));
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X range events example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  pinMode(EVENT_PIN, INPUT_PULLUP);
+
+  // window 100..500 mm, 20 mm hysteresis, a range every 100 ms
+  if (!lox.startRangeEvents(100, 500, 20, onRangeEvent, 100)) {
+    Serial.println(F("Failed to start range events"));
+    while(1);
+  }
+}
+
+void loop() {
+  // nothing to do until the sensor pulls the pin low, a low power sketch
+  // would sleep here with a pin change wake up
+  if (digitalRead(EVENT_PIN) == LOW) {
+    lox.serviceRangeEvents();
+  }
+}
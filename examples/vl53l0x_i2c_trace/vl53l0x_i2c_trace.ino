@@ -0,0 +1,36 @@
+/* This example records every register transaction of a few ranges at full
+ * speed and prints them once done, so printing does not disturb the timing.
+ * Uncomment "#define VL53L0X_I2C_TRACE" in vl53l0x_i2c_platform.h (or define
+ * it for the whole build), save the serial output to a file and decode it
+ * with extras/vl53l0x_trace_decode.py
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define RANGES 3
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X I2C trace example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  // only keep what happens from here on
+  Adafruit_VL53L0X::resetI2CTrace();
+  for (uint8_t i = 0; i < RANGES; i++) {
+    lox.readRange();
+  }
+  Adafruit_VL53L0X::printI2CTrace();
+}
+
+void loop() {
+}
@@ -0,0 +1,45 @@
+/* This example shows where the time of begin() and readRange() goes.
+ * Uncomment "#define VL53L0X_LATENCY_ENABLE" in vl53l0x_platform_log.h (or
+ * define it for the whole build) so the library records how long each of
+ * its internal functions takes, then open the serial monitor.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define RANGES 20
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  uint32_t start;
+
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X latency profile example"));
+  start = micros();
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+  Serial.print(F("begin() took "));
+  Serial.print(micros() - start);
+  Serial.println(F(" us"));
+  Adafruit_VL53L0X::printLatencyProfile();
+
+  Adafruit_VL53L0X::resetLatencyProfile();
+  start = micros();
+  for (uint8_t i = 0; i < RANGES; i++) {
+    lox.readRange();
+  }
+  Serial.print(F("\nreadRange() took "));
+  Serial.print((micros() - start) / RANGES);
+  Serial.println(F(" us on average"));
+  Adafruit_VL53L0X::printLatencyProfile();
+}
+
+void loop() {
+}
@@ -0,0 +1,64 @@
+/* This example takes a range every 2 seconds while keeping the sensor's
+ * average current as low as it can, for battery powered nodes. The duty
+ * cycle picks how the sensor waits between ranges and prints its estimate
+ * of the charge each range costs.
+ * Connect XSHUT to SHUTDOWN_PIN to allow powering the sensor down.
+ */
+#include "Adafruit_VL53L0X_DutyCycle.h"
+
+#define SHUTDOWN_PIN 9
+#define PERIOD_MS 2000
+#define CURRENT_BUDGET_UA 300
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+Adafruit_VL53L0X_DutyCycle duty;
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X low power example"));
+  pinMode(SHUTDOWN_PIN, OUTPUT);
+  digitalWrite(SHUTDOWN_PIN, HIGH);
+  delay(10);
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  if (!duty.begin(&lox, PERIOD_MS, CURRENT_BUDGET_UA, SHUTDOWN_PIN)) {
+    Serial.println(F("Over the current budget, running anyway"));
+  }
+
+  switch (duty.getMode()) {
+  case Adafruit_VL53L0X_DutyCycle::VL53L0X_DUTY_TIMED:
+    Serial.print(F("timed continuous"));
+    break;
+  case Adafruit_VL53L0X_DutyCycle::VL53L0X_DUTY_STANDBY:
+    Serial.print(F("single shot and standby"));
+    break;
+  case Adafruit_VL53L0X_DutyCycle::VL53L0X_DUTY_SHUTDOWN:
+    Serial.print(F("single shot and XSHUT"));
+    break;
+  }
+  Serial.print(F(", "));
+  Serial.print(duty.getChargePerSample());
+  Serial.print(F(" nC per range, "));
+  Serial.print(duty.getChargePerSample() / PERIOD_MS);
+  Serial.println(F(" uA average"));
+}
+
+void loop() {
+  if (duty.poll()) {
+    Serial.print(F("range: "));
+    if (duty.getRangeStatus() != 4) {  // phase failures have incorrect data
+      Serial.println(duty.getRange());
+    } else {
+      Serial.println(F("out of range"));
+    }
+  }
+}
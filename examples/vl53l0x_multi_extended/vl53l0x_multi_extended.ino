@@ -1,4 +1,5 @@
 #include <Adafruit_VL53L0X.h>
+#include <Adafruit_VL53L0X_Scheduler.h>
 #include <Wire.h>
 
 // Define which Wire objects to use, may depend on platform
@@ -17,7 +18,8 @@ typedef enum {
   RUN_MODE_DEFAULT = 1,
   RUN_MODE_ASYNC,
   RUN_MODE_GPIO,
-  RUN_MODE_CONT
+  RUN_MODE_CONT,
+  RUN_MODE_SCHED
 } runmode_t;
 
 runmode_t run_mode = RUN_MODE_DEFAULT;
@@ -68,6 +70,10 @@ const uint16_t ALL_SENSORS_PENDING = ((1 << COUNT_SENSORS) - 1);
 uint16_t sensors_pending = ALL_SENSORS_PENDING;
 uint32_t sensor_last_cycle_time;
 
+// Runs one queue per I2C bus, so SENSOR3/4 on Wire1 range in parallel
+// with SENSOR1/2 on Wire.
+Adafruit_VL53L0X_Scheduler scheduler;
+
 /*
     Reset all sensors by setting all of their XSHUT pins low for delay(10), then
    set all XSHUT high to bring out of reset
@@ -81,29 +87,21 @@ uint32_t sensor_last_cycle_time;
    0x29 and whatever you set the first sensor to
 */
 void Initialize_sensors() {
-  bool found_any_sensors = false;
-  // Set all shutdown pins low to shutdown sensors
+  // The scheduler takes the sensors out of shutdown one by one to set their
+  // ID, then calibrates all of them at once.
   for (int i = 0; i < COUNT_SENSORS; i++)
-    digitalWrite(sensors[i].shutdown_pin, LOW);
-  delay(10);
+    scheduler.addSensor(sensors[i].psensor, sensors[i].pwire, sensors[i].id,
+                        sensors[i].shutdown_pin, sensors[i].sensor_config);
 
-  for (int i = 0; i < COUNT_SENSORS; i++) {
-    // one by one enable sensors and set their ID
-    digitalWrite(sensors[i].shutdown_pin, HIGH);
-    delay(10); // give time to wake up.
-    if (sensors[i].psensor->begin(sensors[i].id, false, sensors[i].pwire,
-                                  sensors[i].sensor_config)) {
-      found_any_sensors = true;
-    } else {
-      Serial.print(i, DEC);
-      Serial.print(F(": failed to start\n"));
-    }
-  }
-  if (!found_any_sensors) {
+  uint32_t start_time = millis();
+  if (!scheduler.beginAll(true)) {
     Serial.println("No valid sensors found");
     while (1)
       ;
   }
+  Serial.print(F("Sensors started in "));
+  Serial.print(millis() - start_time, DEC);
+  Serial.println(F("ms"));
 }
 //====================================================================
 // Simple Sync read sensors.
@@ -313,6 +311,36 @@ void Process_continuous_range() {
   }
 }
 
+//===============================================================
+// Scheduler test code, each bus has its own queue
+//===============================================================
+void start_scheduler() {
+  Serial.print(F("\n*** Scheduler mode, buses: "));
+  Serial.print(scheduler.busCount(), DEC);
+  Serial.println(F(" ***"));
+  scheduler.start();
+}
+
+void Process_scheduler() {
+  if (!scheduler.poll())
+    return;
+
+  // one full cycle, compare the time with what Default/Async modes print
+  digitalWrite(13, !digitalRead(13));
+  Serial.print(scheduler.getCycleTime(), DEC);
+  for (uint8_t i = 0; i < COUNT_SENSORS; i++) {
+    Serial.print(F(" : "));
+    Serial.print(scheduler.getRange(i), DEC);
+    if (scheduler.getRangeStatus(i) == 0)
+      Serial.print(F("  "));
+    else {
+      Serial.print(F("#"));
+      Serial.print(scheduler.getRangeStatus(i), DEC);
+    }
+  }
+  Serial.println();
+}
+
 //====================================================================
 // Setup
 //====================================================================
@@ -376,6 +404,10 @@ void loop() {
     case 'C':
       run_mode = RUN_MODE_CONT;
       break;
+    case 's':
+    case 'S':
+      run_mode = RUN_MODE_SCHED;
+      break;
 
     default:
       show_command_list = 1;
@@ -387,6 +419,8 @@ void loop() {
         stop_continuous_range();
       if (run_mode == RUN_MODE_CONT)
         start_continuous_range(cycle_time);
+      if (run_mode == RUN_MODE_SCHED)
+        start_scheduler();
     } else if (run_mode == RUN_MODE_CONT) {
       // Already was in continuous but maybe different speed, try to update
       start_continuous_range(cycle_time);
@@ -401,6 +435,8 @@ void loop() {
     Serial.println(F("    G - Asynchronous mode - Like above use GPIO pins"));
     Serial.println(
         F("    C - Continuous mode - Try starting all Seonsors at once"));
+    Serial.println(
+        F("    S - Scheduler mode - One queue per I2C bus, in parallel"));
     show_command_list = 0;
   }
   switch (run_mode) {
@@ -416,7 +452,10 @@ void loop() {
   case RUN_MODE_CONT:
     Process_continuous_range();
     break;
+  case RUN_MODE_SCHED:
+    Process_scheduler();
+    break;
   }
-  if (run_mode != RUN_MODE_CONT)
+  if ((run_mode != RUN_MODE_CONT) && (run_mode != RUN_MODE_SCHED))
     delay(250);
 }
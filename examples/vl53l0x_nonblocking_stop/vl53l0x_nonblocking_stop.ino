@@ -0,0 +1,70 @@
+/* This example ranges continuously and every few seconds stops to take a
+ * precise reading, without stalling loop() while the sensor finishes the
+ * range it was busy with. requestStopRangeContinuous() returns straight away
+ * and serviceStop(), called from loop(), completes the stop later.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define SWITCH_MS 5000
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+uint32_t lastSwitch = 0;
+uint32_t loopsWhileStopping = 0;
+boolean stopped = false;
+
+void onStopped(VL53L0X_Error status, void *context) {
+  (void)context;
+  Serial.print(F("Stopped, status "));
+  Serial.print(status);
+  Serial.print(F(", loop() ran "));
+  Serial.print(loopsWhileStopping);
+  Serial.println(F(" times meanwhile"));
+  stopped = true;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X non-blocking stop example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  lox.startRangeContinuous();
+  lastSwitch = millis();
+}
+
+void loop() {
+  if (lox.isStopping()) {
+    // the rest of the control loop keeps running here
+    loopsWhileStopping++;
+    lox.serviceStop();
+    return;
+  }
+
+  if (stopped) {
+    stopped = false;
+    Serial.print(F("Single range: "));
+    Serial.println(lox.readRange());
+    lox.startRangeContinuous();
+    lastSwitch = millis();
+    return;
+  }
+
+  if (lox.isRangeComplete()) {
+    Serial.print(F("Distance in mm: "));
+    Serial.println(lox.readRangeResult());
+  }
+
+  if ((millis() - lastSwitch) >= SWITCH_MS) {
+    loopsWhileStopping = 0;
+    lox.requestStopRangeContinuous(onStopped);
+  }
+}
@@ -0,0 +1,60 @@
+/* This example compares a burst of short ranges averaged by
+ * readRangePrecise() with one 200 ms VL53L0X_SENSE_HIGH_ACCURACY range.
+ * Point the sensor at a fixed target and compare how much each reading
+ * moves around, and how long it took.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define SAMPLES 8 // short ranges per precise reading
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X precision example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+}
+
+void loop() {
+  float range, uncertainty;
+  uint32_t start;
+
+  lox.configSensor(Adafruit_VL53L0X::VL53L0X_SENSE_HIGH_SPEED);
+  start = millis();
+  if (lox.readRangePrecise(SAMPLES, &range, &uncertainty)) {
+    Serial.print(F("burst: "));
+    Serial.print(range, 2);
+    Serial.print(F(" +/- "));
+    Serial.print(uncertainty, 2);
+    Serial.print(F(" mm in "));
+    Serial.print(millis() - start);
+    Serial.println(F(" ms"));
+  } else {
+    Serial.println(F("burst: out of range"));
+  }
+
+  lox.configSensor(Adafruit_VL53L0X::VL53L0X_SENSE_HIGH_ACCURACY);
+  start = millis();
+  uint16_t single = lox.readRange();
+  uint32_t single_time = millis() - start;
+  Serial.print(F("single: "));
+  if (lox.readRangeStatus() != 4) {  // phase failures have incorrect data
+    Serial.print(single);
+  } else {
+    Serial.print(F("out of range"));
+  }
+  Serial.print(F(" mm in "));
+  Serial.print(single_time);
+  Serial.println(F(" ms"));
+
+  delay(500);
+}
@@ -0,0 +1,83 @@
+/* This example shows how to switch between a long range, a high speed
+ * and a 25 ms configuration at run time. The first two are compiled once in
+ * setup(), the third is built by the compiler, switching is then a few
+ * register writes instead of a VCSEL phase calibration. The time each
+ * switch takes is printed next to the range.
+ */
+#include "Adafruit_VL53L0X.h"
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+VL53L0X_Profile_t long_range;
+VL53L0X_Profile_t high_speed;
+
+// 25 ms budget, default VCSEL periods, 0.25 MCPS signal and 32 mm sigma
+// limits. Change 25000 to 15000 and it no longer compiles.
+constexpr VL53L0X_Profile_t fast_25ms = Adafruit_VL53L0X_Profile::build(
+    25000, 14, 10, (FixPoint1616_t)(0.25 * 65536), 32 * 65536);
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X profile switching example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  if (!lox.compileProfile(Adafruit_VL53L0X::VL53L0X_SENSE_LONG_RANGE,
+                          &long_range) ||
+      !lox.compileProfile(Adafruit_VL53L0X::VL53L0X_SENSE_HIGH_SPEED,
+                          &high_speed)) {
+    Serial.println(F("Failed to compile profiles"));
+    while(1);
+  }
+
+  // for comparison, the slow way
+  uint32_t start = micros();
+  lox.configSensor(Adafruit_VL53L0X::VL53L0X_SENSE_LONG_RANGE);
+  Serial.print(F("configSensor(): "));
+  Serial.print(micros() - start);
+  Serial.println(F(" us"));
+}
+
+void loop() {
+  static uint8_t profile = 0;
+  uint32_t start = micros();
+
+  profile = (profile + 1) % 3;
+  if (profile == 0) {
+    lox.applyProfile(&long_range);
+  } else if (profile == 1) {
+    lox.applyProfile(&high_speed);
+  } else {
+    // the first time this runs a phase calibration, then it is as fast
+    lox.applyProfile(&fast_25ms);
+  }
+  uint32_t switch_time = micros() - start;
+
+  uint16_t range = lox.readRange();
+
+  if (profile == 0) {
+    Serial.print(F("long range "));
+  } else if (profile == 1) {
+    Serial.print(F("high speed "));
+  } else {
+    Serial.print(F("25 ms "));
+  }
+  Serial.print(F("switch: "));
+  Serial.print(switch_time);
+  Serial.print(F(" us, range: "));
+  if (lox.readRangeStatus() != 4) {  // phase failures have incorrect data
+    Serial.println(range);
+  } else {
+    Serial.println(F("out of range"));
+  }
+
+  delay(500);
+}
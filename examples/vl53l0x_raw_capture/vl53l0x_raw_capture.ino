@@ -0,0 +1,39 @@
+/* This example logs the raw result registers of every range next to the
+ * decoded range. Save the serial output and feed it to extras/replay to
+ * decode the same ranges again on a computer, e.g. after changing the
+ * library, and compare.
+ */
+#include "Adafruit_VL53L0X.h"
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X raw capture example"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  // the configuration goes first, the raw results depend on it
+  lox.printDecodeConfig();
+  lox.setRawResultCallback(Adafruit_VL53L0X::printRawResult);
+}
+
+void loop() {
+  VL53L0X_RangingMeasurementData_t measure;
+
+  lox.rangingTest(&measure, false);
+  Serial.print(F("range "));
+  Serial.print(measure.RangeMilliMeter);
+  Serial.print(F(" status "));
+  Serial.println(measure.RangeStatus);
+
+  delay(100);
+}
@@ -0,0 +1,52 @@
+/* This example ranges continuously through the scheduler and reruns the
+   VHV and phase calibrations in the background, every minute or as soon as
+   the reference signal rate moved by 5% (the sensor warmed up or cooled
+   down). Each recalibration takes the place of one range, the sketch prints
+   how much later than usual it made the next sample arrive. */
+
+#include "Adafruit_VL53L0X.h"
+#include "Adafruit_VL53L0X_Scheduler.h"
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+Adafruit_VL53L0X_Scheduler scheduler;
+
+uint32_t recalibrations = 0;
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (!Serial) {
+    delay(1);
+  }
+
+  Serial.println("Adafruit VL53L0X background recalibration");
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while (1)
+      ;
+  }
+
+  scheduler.addSensor(&lox);
+  scheduler.setRecalibration(60000, 5);
+  scheduler.start();
+}
+
+void loop() {
+  if (!scheduler.poll())
+    return;
+
+  Serial.print(F("Distance (mm): "));
+  if (scheduler.getRangeStatus(0) == 0)
+    Serial.println(scheduler.getRange(0));
+  else
+    Serial.println(F("out of range"));
+
+  if (scheduler.getRecalibrationCount() != recalibrations) {
+    recalibrations = scheduler.getRecalibrationCount();
+    Serial.print(F("Recalibrated, reference rate (MCPS): "));
+    Serial.print(lox.getReferenceSignalRate() / 65536.0);
+    Serial.print(F(", worst gap so far (us): "));
+    Serial.println(scheduler.getRecalibrationGap());
+  }
+}
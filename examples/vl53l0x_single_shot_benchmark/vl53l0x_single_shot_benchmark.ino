@@ -0,0 +1,93 @@
+/* This example compares readRange() with readRangeFast(), which sets the
+ * sensor up for single ranges once and then only starts, waits for, reads and
+ * acknowledges each range, and with readRangeResultAndRearm(), which also
+ * starts the next range while reading the last one. It prints the time per
+ * range of each, and with VL53L0X_I2C_TRACE defined (see
+ * vl53l0x_i2c_platform.h) the number of I2C transactions per range as well.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define RANGES 50
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+uint16_t readRange() { return lox.readRange(); }
+
+uint16_t readRangeFast() { return lox.readRangeFast(); }
+
+// the range read here was started by the previous call
+uint16_t readRangeRearm() {
+  lox.waitRangeComplete();
+  return lox.readRangeResultAndRearm(false);
+}
+
+uint16_t readRangeRearmChecked() {
+  lox.waitRangeComplete();
+  return lox.readRangeResultAndRearm(true);
+}
+
+void run(const char *name, uint16_t (*read)(void), boolean rearm = false) {
+  uint32_t start, elapsed;
+  uint16_t errors = 0;
+
+  // the rearm reads collect a range started before them
+  if (rearm)
+    lox.startRange();
+  // the first range includes the set up, leave it out
+  read();
+
+#ifdef VL53L0X_I2C_TRACE
+  VL53L0X_i2c_trace_reset();
+#endif
+  start = micros();
+  for (uint16_t i = 0; i < RANGES; i++) {
+    if (read() == 0xffff)
+      errors++;
+  }
+  elapsed = micros() - start;
+
+  if (rearm) {
+    lox.waitRangeComplete();
+    lox.readRangeResult();
+  }
+
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.print(elapsed / RANGES);
+  Serial.print(F(" us per range"));
+#ifdef VL53L0X_I2C_TRACE
+  Serial.print(F(", "));
+  Serial.print((float)VL53L0X_i2c_trace_total() / RANGES);
+  Serial.print(F(" transactions per range"));
+#endif
+  Serial.print(F(", "));
+  Serial.print(errors);
+  Serial.println(F(" errors"));
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X single shot benchmark"));
+  if (!lox.begin()) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  // the shortest budget makes the I2C overhead stand out
+  lox.setMeasurementTimingBudgetMicroSeconds(20000);
+}
+
+void loop() {
+  run("readRange()              ", readRange);
+  run("readRangeFast()          ", readRangeFast);
+  run("rearm, interrupt checked ", readRangeRearmChecked, true);
+  run("rearm                    ", readRangeRearm, true);
+  Serial.println();
+  delay(2000);
+}
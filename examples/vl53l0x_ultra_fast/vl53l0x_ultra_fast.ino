@@ -0,0 +1,65 @@
+/* This example ranges as fast as the sensor allows, for things like
+ * detecting the gaps between boxes on a conveyor close to the sensor.
+ * VL53L0X_SENSE_ULTRA_FAST turns off the optional steps of a range and
+ * uses the shortest timing budget that leaves.
+ */
+#include "Adafruit_VL53L0X.h"
+
+#define GAP_MM 150 // anything further away than this is a gap
+
+Adafruit_VL53L0X lox = Adafruit_VL53L0X();
+
+void setup() {
+  Serial.begin(115200);
+
+  // wait until serial port opens for native USB devices
+  while (! Serial) {
+    delay(1);
+  }
+
+  Serial.println(F("Adafruit VL53L0X ultra fast example"));
+  if (!lox.begin(VL53L0X_I2C_ADDR, false, &Wire,
+                 Adafruit_VL53L0X::VL53L0X_SENSE_ULTRA_FAST)) {
+    Serial.println(F("Failed to boot VL53L0X"));
+    while(1);
+  }
+
+  VL53L0X_SchedulerSequenceSteps_t steps;
+  lox.getSequenceStepEnables(&steps);
+  Serial.print(F("TCC/MSRC/DSS/pre/final: "));
+  Serial.print(steps.TccOn);
+  Serial.print(steps.MsrcOn);
+  Serial.print(steps.DssOn);
+  Serial.print(steps.PreRangeOn);
+  Serial.println(steps.FinalRangeOn);
+  Serial.print(F("Shortest budget: "));
+  Serial.print(lox.getMinimumTimingBudgetMicroSeconds());
+  Serial.println(F(" us"));
+
+  // back to back ranging
+  lox.startRangeContinuous(0);
+}
+
+void loop() {
+  static bool in_gap = false;
+  static uint16_t samples = 0;
+  static uint32_t second = millis();
+
+  if (lox.isRangeComplete()) {
+    uint16_t range = lox.readRangeResult();
+    bool gap = (range == 0xffff) || (range > GAP_MM);
+
+    if (gap != in_gap) {
+      in_gap = gap;
+      Serial.println(gap ? F("gap") : F("box"));
+    }
+    samples++;
+  }
+
+  if (millis() - second >= 1000) {
+    Serial.print(samples);
+    Serial.println(F(" samples/s"));
+    samples = 0;
+    second += 1000;
+  }
+}
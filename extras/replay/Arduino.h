@@ -0,0 +1,20 @@
+/* Just enough of Arduino.h to build the VL53L0X PAL on a host, for
+ * vl53l0x_replay.cpp. Nothing here talks to hardware. */
+#ifndef VL53L0X_REPLAY_ARDUINO_H
+#define VL53L0X_REPLAY_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+/* for the PAL tick count, process time is as good as any */
+static inline unsigned long millis(void) {
+  return (unsigned long)(1000.0 * clock() / CLOCKS_PER_SEC);
+}
+
+#endif
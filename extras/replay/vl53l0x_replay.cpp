@@ -0,0 +1,152 @@
+/*!
+ * @file vl53l0x_replay.cpp
+ *
+ * Host side replay of VL53L0X ranges captured with
+ * Adafruit_VL53L0X::printDecodeConfig() and printRawResult().
+ *
+ * Every "R" line of the capture goes through VL53L0X_decode_ranging_result(),
+ * the same decode, range status and sigma code the sensor library runs, with
+ * the configuration of the last "C" line before it. The decoded fields are
+ * printed as integers, one line per range, so the output of two versions of
+ * the library can be compared with diff. With -b the decode is timed instead.
+ *
+ * Build from the root of the library, with every .cpp file of src/core/src
+ * and src/platform/src:
+ *
+ *   g++ -O2 -Iextras/replay -Isrc extras/replay/vl53l0x_replay.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_replay
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_api_core.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+
+TwoWire Wire;
+
+/** A range as captured, with the configuration it was taken with */
+typedef struct {
+  size_t config;           ///< index into the configurations
+  VL53L0X_RawResult_t raw; ///< the captured result
+} replay_record_t;
+
+static bool parseHex(const char *text, uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++) {
+    unsigned int byte;
+    if (sscanf(text + 2 * i, "%2x", &byte) != 1)
+      return false;
+    buffer[i] = (uint8_t)byte;
+  }
+  return true;
+}
+
+static VL53L0X_Error decode(VL53L0X_DEV Dev, const replay_record_t *record,
+                            VL53L0X_RangingMeasurementData_t *measure) {
+  memset(measure, 0, sizeof(*measure));
+  return VL53L0X_decode_ranging_result(Dev, &record->raw, measure);
+}
+
+int main(int argc, char **argv) {
+  std::vector<VL53L0X_DecodeConfig_t> configs;
+  std::vector<replay_record_t> records;
+  VL53L0X_RangingMeasurementData_t measure;
+  VL53L0X_Dev_t device;
+  VL53L0X_DEV Dev = &device;
+  unsigned long repeat = 0;
+  const char *path = NULL;
+  char line[256];
+  FILE *file;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-b") && (i + 1 < argc))
+      repeat = strtoul(argv[++i], NULL, 0);
+    else
+      path = argv[i];
+  }
+  if (path == NULL) {
+    fprintf(stderr, "usage: %s [-b repeat] capture.txt\n", argv[0]);
+    return 2;
+  }
+
+  file = fopen(path, "r");
+  if (file == NULL) {
+    perror(path);
+    return 2;
+  }
+
+  while (fgets(line, sizeof(line), file)) {
+    uint8_t packed[VL53L0X_DECODE_CONFIG_PACKED_SIZE];
+
+    if (!strncmp(line, "C ", 2) &&
+        parseHex(line + 2, packed, VL53L0X_DECODE_CONFIG_PACKED_SIZE)) {
+      VL53L0X_DecodeConfig_t config;
+      if (VL53L0X_unpack_decode_config(packed, &config) !=
+          VL53L0X_ERROR_NONE) {
+        fprintf(stderr, "unsupported configuration version %u\n", packed[0]);
+        return 1;
+      }
+      configs.push_back(config);
+    } else if (!strncmp(line, "R ", 2) &&
+               parseHex(line + 2, packed, VL53L0X_RAW_RESULT_PACKED_SIZE)) {
+      replay_record_t record;
+      if (configs.empty()) {
+        fprintf(stderr, "result before any configuration\n");
+        return 1;
+      }
+      record.config = configs.size() - 1;
+      VL53L0X_unpack_raw_result(packed, &record.raw);
+      records.push_back(record);
+    }
+  }
+  fclose(file);
+
+  memset(&device, 0, sizeof(device));
+
+  if (repeat) {
+    // decode everything repeat times, the checksum keeps the work alive
+    uint32_t checksum = 0;
+    size_t config = (size_t)-1;
+    clock_t start = clock();
+
+    for (unsigned long n = 0; n < repeat; n++) {
+      for (size_t i = 0; i < records.size(); i++) {
+        if (records[i].config != config) {
+          config = records[i].config;
+          VL53L0X_set_decode_config(Dev, &configs[config]);
+        }
+        decode(Dev, &records[i], &measure);
+        checksum += measure.RangeMilliMeter + measure.RangeStatus;
+      }
+    }
+
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    double samples = (double)repeat * records.size();
+    printf("%.0f ranges in %.3f s, %.1f ns per range, checksum %08x\n",
+           samples, seconds, samples ? 1e9 * seconds / samples : 0.0,
+           checksum);
+    return 0;
+  }
+
+  printf("# range_mm fraction status signal_1616 ambient_1616 spads_88 "
+         "dmax_mm sigma_1616 error\n");
+  for (size_t i = 0; i < records.size(); i++) {
+    VL53L0X_Error error;
+
+    if ((i == 0) || (records[i].config != records[i - 1].config))
+      VL53L0X_set_decode_config(Dev, &configs[records[i].config]);
+    error = decode(Dev, &records[i], &measure);
+    printf("%u %u %u %u %u %u %u %u %d\n", measure.RangeMilliMeter,
+           measure.RangeFractionalPart, measure.RangeStatus,
+           measure.SignalRateRtnMegaCps, measure.AmbientRateRtnMegaCps,
+           measure.EffectiveSpadRtnCount, measure.RangeDMaxMilliMeter,
+           PALDevDataGet(Dev, SigmaEstimate), error);
+  }
+
+  return 0;
+}
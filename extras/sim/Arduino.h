@@ -0,0 +1,64 @@
+/* Just enough of Arduino.h to build the library on a host against the
+ * register model in vl53l0x_sim.cpp, which provides the functions declared
+ * here. Printing goes nowhere. */
+#ifndef VL53L0X_SIM_ARDUINO_H
+#define VL53L0X_SIM_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define DEC 10
+#define HEX 16
+#define F(x) x
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+
+class Print {
+public:
+  size_t print(const char *) { return 0; }
+  size_t print(char) { return 0; }
+  size_t print(int, int = DEC) { return 0; }
+  size_t print(unsigned int, int = DEC) { return 0; }
+  size_t print(long, int = DEC) { return 0; }
+  size_t print(unsigned long, int = DEC) { return 0; }
+  size_t print(double, int = 2) { return 0; }
+  size_t println(const char *) { return 0; }
+  size_t println(char) { return 0; }
+  size_t println(int, int = DEC) { return 0; }
+  size_t println(unsigned int, int = DEC) { return 0; }
+  size_t println(long, int = DEC) { return 0; }
+  size_t println(unsigned long, int = DEC) { return 0; }
+  size_t println(double, int = 2) { return 0; }
+  size_t println(void) { return 0; }
+  size_t write(uint8_t) { return 1; }
+};
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long) {}
+  operator bool() { return true; }
+  int available(void) { return 0; }
+  int read(void) { return -1; }
+  void flush(void) {}
+};
+
+extern HardwareSerial Serial;
+
+#endif
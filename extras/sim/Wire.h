@@ -0,0 +1,23 @@
+/* The TwoWire interface the library uses, implemented by the register model
+ * in vl53l0x_sim.cpp. */
+#ifndef VL53L0X_SIM_WIRE_H
+#define VL53L0X_SIM_WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+public:
+  void begin(void) {}
+  void setClock(uint32_t) {}
+  void beginTransmission(uint8_t address);
+  uint8_t endTransmission(bool stop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t count, uint8_t stop = 1);
+  size_t write(uint8_t value);
+  int read(void);
+  int available(void) { return 1; }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#endif
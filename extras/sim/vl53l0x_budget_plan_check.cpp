@@ -0,0 +1,98 @@
+/*!
+ * @file vl53l0x_budget_plan_check.cpp
+ *
+ * Checks that VL53L0X_set_budget_from_plan() leaves the same final range
+ * timeout, in the register and in the driver state, and returns the same
+ * status as VL53L0X_SetMeasurementTimingBudgetMicroSeconds(), over
+ * sequence step sets, VCSEL period pairs and budgets from 20 to 400 ms.
+ * Runs on the register model of vl53l0x_sim.cpp, prints the cases that
+ * differ and exits with their number.
+ *
+ * Build from the root of the library:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_budget_plan_check.cpp extras/sim/vl53l0x_sim.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_budget_plan_check
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_api_core.h"
+#include "vl53l0x_sim.h"
+
+static VL53L0X_Dev_t dev;
+
+static void setupDevice(uint8_t sequence, uint8_t pre, uint8_t final) {
+  sim_reset();
+  sim_regs[0][0x01] = sequence; // SYSTEM_SEQUENCE_CONFIG
+  sim_regs[0][0x46] = 0x25;     // MSRC_CONFIG_TIMEOUT_MACROP
+  sim_regs[0][0x50] = 0x06;     // PRE_RANGE_CONFIG_VCSEL_PERIOD
+  sim_regs[0][0x51] = 0x00;     // PRE_RANGE_CONFIG_TIMEOUT_MACROP
+  sim_regs[0][0x52] = 0x96;
+  sim_regs[0][0x70] = 0x04; // FINAL_RANGE_CONFIG_VCSEL_PERIOD
+
+  memset(&dev, 0, sizeof(dev));
+  dev.I2cDevAddr = 0x29;
+  dev.i2c = &Wire;
+  dev.Data.SequenceConfig = sequence;
+  dev.Data.DeviceSpecificParameters.Pin0GpioFunctionality =
+      VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY;
+  VL53L0X_SetVcselPulsePeriod(&dev, VL53L0X_VCSEL_PERIOD_PRE_RANGE, pre);
+  VL53L0X_SetVcselPulsePeriod(&dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE, final);
+}
+
+static uint16_t finalRangeRegister(void) {
+  return (sim_regs[0][0x71] << 8) | sim_regs[0][0x72];
+}
+
+int main(void) {
+  static const uint8_t sequences[] = {0xFF, 0xE8, 0xC0, 0x80, 0x94};
+  static const uint8_t vcsel[][2] = {{14, 10}, {18, 14}, {12, 8}};
+  int cases = 0;
+  int failures = 0;
+
+  for (uint8_t sequence : sequences) {
+    for (const uint8_t *period : vcsel) {
+      for (uint32_t budget = 20000; budget <= 400000; budget = budget * 5 / 4) {
+        VL53L0X_BudgetPlan_t plan;
+        VL53L0X_Error setter_status, plan_status;
+        uint16_t setter_register, plan_register;
+        uint32_t setter_timeout, plan_timeout;
+
+        setupDevice(sequence, period[0], period[1]);
+        setter_status =
+            VL53L0X_SetMeasurementTimingBudgetMicroSeconds(&dev, budget);
+        setter_register = finalRangeRegister();
+        setter_timeout =
+            dev.Data.DeviceSpecificParameters.FinalRangeTimeoutMicroSecs;
+
+        setupDevice(sequence, period[0], period[1]);
+        plan_status = VL53L0X_get_budget_plan(&dev, &plan);
+        if (plan_status == VL53L0X_ERROR_NONE)
+          plan_status = VL53L0X_set_budget_from_plan(&dev, &plan, budget);
+        plan_register = finalRangeRegister();
+        plan_timeout =
+            dev.Data.DeviceSpecificParameters.FinalRangeTimeoutMicroSecs;
+
+        cases++;
+        if ((setter_status != plan_status) ||
+            ((setter_status == VL53L0X_ERROR_NONE) &&
+             ((setter_register != plan_register) ||
+              (setter_timeout != plan_timeout)))) {
+          printf("sequence %02x, VCSEL %u/%u, %u us: setter %d %04x %u, "
+                 "plan %d %04x %u\n",
+                 sequence, period[0], period[1], budget, setter_status,
+                 setter_register, setter_timeout, plan_status, plan_register,
+                 plan_timeout);
+          failures++;
+        }
+      }
+    }
+  }
+
+  printf("%d cases, %d differ\n", cases, failures);
+  return failures;
+}
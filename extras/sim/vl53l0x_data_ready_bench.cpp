@@ -0,0 +1,65 @@
+/*!
+ * @file vl53l0x_data_ready_bench.cpp
+ *
+ * Counts the I2C transactions per range of a loop() spinning on
+ * isRangeComplete() and reading each range with readRangeResult(), in
+ * continuous ranging on the register model of vl53l0x_sim.cpp. It runs once
+ * polling the data ready status over I2C and once reading GPIO1 on a pin
+ * given to setDataReadyPin(). Ranges take 20 ms.
+ *
+ * Build from the root of the library:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_data_ready_bench.cpp extras/sim/vl53l0x_sim.cpp \
+ *       src/Adafruit_VL53L0X.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_data_ready_bench
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X.h"
+#include "vl53l0x_sim.h"
+
+#define RANGES 50        ///< ranges per figure
+#define DATA_READY_PIN 2 ///< any pin, the model reads GPIO1 on all of them
+
+static void run(const char *name, Adafruit_VL53L0X *lox) {
+  unsigned long polls = 0;
+  unsigned long startTime;
+
+  lox->startRangeContinuous();
+  lox->waitRangeComplete(); // the first range pays for the start
+  lox->readRangeResult();
+
+  sim_clear_counts();
+  startTime = sim_now_us;
+  for (int i = 0; i < RANGES; i++) {
+    while (!lox->isRangeComplete())
+      polls++;
+    lox->readRangeResult();
+  }
+  printf("%-17s %6.1f transactions, %6.1f polls, %5.1f ms per range, "
+         "status %d\n",
+         name, (double)(sim_writes + sim_reads) / RANGES,
+         (double)polls / RANGES, (sim_now_us - startTime) / 1000.0 / RANGES,
+         lox->Status);
+  lox->stopRangeContinuous();
+}
+
+int main(void) {
+  Adafruit_VL53L0X lox;
+
+  sim_reset();
+  if (!lox.begin()) {
+    printf("begin() failed, status %d\n", lox.Status);
+    return 1;
+  }
+  sim_range_us = 20000;
+
+  run("register polling", &lox);
+  lox.setDataReadyPin(DATA_READY_PIN);
+  run("pin", &lox);
+  return 0;
+}
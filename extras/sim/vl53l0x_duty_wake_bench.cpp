@@ -0,0 +1,68 @@
+/*!
+ * @file vl53l0x_duty_wake_bench.cpp
+ *
+ * Counts the I2C transactions of the wakes from XSHUT of
+ * Adafruit_VL53L0X_DutyCycle in VL53L0X_DUTY_SHUTDOWN mode, on the register
+ * model of vl53l0x_sim.cpp: one range every 5 minutes within 10 uA. The
+ * first wake fills the NVM cache, the later ones read it. A begin() with
+ * the same timing budget, what every wake used to run, is counted for
+ * comparison. The model keeps its registers while XSHUT is low, which the
+ * init does not depend on.
+ *
+ * Build from the root of the library:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_duty_wake_bench.cpp extras/sim/vl53l0x_sim.cpp \
+ *       src/Adafruit_VL53L0X.cpp src/Adafruit_VL53L0X_DutyCycle.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_duty_wake_bench
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X_DutyCycle.h"
+#include "vl53l0x_sim.h"
+
+#define PERIOD_MS 300000 ///< time between ranges
+#define CURRENT_UA 10    ///< average current budget
+#define XSHUT_PIN 3      ///< any pin, the model ignores XSHUT
+#define WAKES 5          ///< wakes counted
+
+int main(void) {
+  Adafruit_VL53L0X lox;
+  Adafruit_VL53L0X_DutyCycle duty;
+  uint32_t budget;
+
+  sim_reset();
+  if (!lox.begin()) {
+    printf("begin() failed, status %d\n", lox.Status);
+    return 1;
+  }
+  if (!duty.begin(&lox, PERIOD_MS, CURRENT_UA, XSHUT_PIN) ||
+      (duty.getMode() != Adafruit_VL53L0X_DutyCycle::VL53L0X_DUTY_SHUTDOWN)) {
+    printf("duty cycle not in shutdown mode, status %d\n", lox.Status);
+    return 1;
+  }
+  budget = lox.getMeasurementTimingBudgetMicroSeconds();
+
+  for (int i = 0; i < WAKES; i++) {
+    delay(PERIOD_MS);
+    // the poll that is due wakes the sensor and starts the range
+    sim_clear_counts();
+    duty.poll();
+    printf("wake %d: %4lu transactions, status %d\n", i + 1,
+           sim_writes + sim_reads, lox.Status);
+    while (!duty.poll())
+      ;
+  }
+  duty.end();
+
+  sim_clear_counts();
+  if (!lox.begin() || !lox.setMeasurementTimingBudgetMicroSeconds(budget)) {
+    printf("begin() failed, status %d\n", lox.Status);
+    return 1;
+  }
+  printf("begin():  %4lu transactions\n", sim_writes + sim_reads);
+  return 0;
+}
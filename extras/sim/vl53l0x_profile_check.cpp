@@ -0,0 +1,160 @@
+/*!
+ * @file vl53l0x_profile_check.cpp
+ *
+ * Checks the register images of Adafruit_VL53L0X_Profile::build() against
+ * what the runtime setters leave in the register model of vl53l0x_sim.cpp,
+ * read back with VL53L0X_capture_profile(). Prints one line per
+ * budget/VCSEL/limit combination and exits with the number of mismatches.
+ *
+ * Build from the root of the library:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_profile_check.cpp extras/sim/vl53l0x_sim.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_profile_check
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X_Profile.h"
+#include "vl53l0x_api.h"
+#include "vl53l0x_api_core.h"
+#include "vl53l0x_sim.h"
+
+static VL53L0X_Dev_t dev;
+static int failures;
+
+/** Timeouts and VCSEL periods of a sensor after DataInit and StaticInit */
+static void setupDevice(void) {
+  sim_reset();
+  sim_regs[0][0x01] = 0xE8; // SYSTEM_SEQUENCE_CONFIG
+  sim_regs[0][0x46] = 0x25; // MSRC_CONFIG_TIMEOUT_MACROP
+  sim_regs[0][0x50] = 0x06; // PRE_RANGE_CONFIG_VCSEL_PERIOD
+  sim_regs[0][0x51] = 0x00; // PRE_RANGE_CONFIG_TIMEOUT_MACROP
+  sim_regs[0][0x52] = 0x96;
+  sim_regs[0][0x70] = 0x04; // FINAL_RANGE_CONFIG_VCSEL_PERIOD
+  sim_regs[0][0x71] = 0x01; // FINAL_RANGE_CONFIG_TIMEOUT_MACROP
+  sim_regs[0][0x72] = 0x00;
+  sim_regs[0][0x60] = 0x12; // MSRC_CONFIG_CONTROL
+  sim_regs[0][0x44] = 0x00; // FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT
+  sim_regs[0][0x45] = 0x20;
+  sim_regs[0][0x47] = 0x08; // PRE_RANGE_CONFIG_VALID_PHASE
+  sim_regs[0][0x48] = 0x28;
+  sim_regs[0][0x56] = 0x08;
+  sim_regs[0][0x57] = 0x30;
+  sim_regs[0][0x30] = 0x09;
+  sim_regs[0][0x32] = 0x03;
+  sim_regs[1][0x30] = 0x20;
+
+  memset(&dev, 0, sizeof(dev));
+  dev.I2cDevAddr = 0x29;
+  dev.i2c = &Wire;
+  dev.Data.SequenceConfig = 0xE8;
+  dev.Data.DeviceSpecificParameters.Pin0GpioFunctionality =
+      VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY;
+  dev.Data.CurrentParameters.MeasurementTimingBudgetMicroSeconds = 33000;
+}
+
+static void check(uint32_t budget, uint8_t pre, uint8_t final,
+                  FixPoint1616_t signal, FixPoint1616_t sigma,
+                  const VL53L0X_Profile_t &built) {
+  VL53L0X_Profile_t captured;
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+  int bad = 0;
+
+  setupDevice();
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetVcselPulsePeriod(&dev, VL53L0X_VCSEL_PERIOD_PRE_RANGE,
+                                         pre);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetVcselPulsePeriod(
+        &dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE, final);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetMeasurementTimingBudgetMicroSeconds(&dev, budget);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetLimitCheckEnable(
+        &dev, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE, sigma != 0);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetLimitCheckEnable(
+        &dev, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE, signal != 0);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetLimitCheckValue(
+        &dev, VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE, sigma);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_SetLimitCheckValue(
+        &dev, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE, signal);
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_capture_profile(&dev, &captured);
+
+  printf("%6u us, VCSEL %2u/%2u:", budget, pre, final);
+  if (status != VL53L0X_ERROR_NONE) {
+    printf(" error %d\n", status);
+    failures++;
+    return;
+  }
+
+  for (int i = 0; i < VL53L0X_PROFILE_REGISTER_COUNT; i++) {
+    if (captured.Registers[i] != built.Registers[i]) {
+      printf(" register %d %02x!=%02x", i, captured.Registers[i],
+             built.Registers[i]);
+      bad = 1;
+    }
+  }
+  if (captured.PhasecalLimit != built.PhasecalLimit) {
+    printf(" phasecal limit");
+    bad = 1;
+  }
+  if (captured.PreRangeTimeoutMicroSecs != built.PreRangeTimeoutMicroSecs) {
+    printf(" pre-range timeout %u!=%u", captured.PreRangeTimeoutMicroSecs,
+           built.PreRangeTimeoutMicroSecs);
+    bad = 1;
+  }
+  if (captured.FinalRangeTimeoutMicroSecs !=
+      built.FinalRangeTimeoutMicroSecs) {
+    printf(" final range timeout %u!=%u", captured.FinalRangeTimeoutMicroSecs,
+           built.FinalRangeTimeoutMicroSecs);
+    bad = 1;
+  }
+  if (captured.LastEncodedTimeout != built.LastEncodedTimeout) {
+    printf(" last encoded timeout");
+    bad = 1;
+  }
+  for (int i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
+    if ((captured.LimitChecksEnable[i] != built.LimitChecksEnable[i]) ||
+        (captured.LimitChecksEnable[i] &&
+         (captured.LimitChecksValue[i] != built.LimitChecksValue[i]))) {
+      printf(" limit check %d", i);
+      bad = 1;
+    }
+  }
+
+  printf(bad ? " MISMATCH\n" : " ok\n");
+  failures += bad;
+}
+
+/* the profile has to be a constant expression, or this does not build */
+#define CHECK(budget, pre, final, signal, sigma)                               \
+  do {                                                                         \
+    constexpr VL53L0X_Profile_t built = Adafruit_VL53L0X_Profile::build(       \
+        budget, pre, final, signal, sigma);                                    \
+    check(budget, pre, final, signal, sigma, built);                           \
+  } while (0)
+
+int main(void) {
+  CHECK(25000, 14, 10, 16384, 32 * 65536);
+  CHECK(33000, 14, 10, 16384, 0);
+  CHECK(200000, 14, 10, 16384, 18 * 65536);
+  CHECK(33000, 18, 14, 6554, 60 * 65536);
+  CHECK(50000, 12, 8, 16384, 32 * 65536);
+  CHECK(20000, 16, 12, 16384, 32 * 65536);
+  CHECK(100000, 18, 12, 0, 0);
+
+  static_assert(!Adafruit_VL53L0X_Profile::isValid(15000, 14, 10),
+                "budget too short");
+  static_assert(!Adafruit_VL53L0X_Profile::isValid(33000, 13, 10),
+                "odd VCSEL period");
+
+  printf("%d mismatches\n", failures);
+  return failures;
+}
@@ -0,0 +1,206 @@
+/*!
+ * @file vl53l0x_sim.cpp
+ *
+ * Register model of one VL53L0X, see vl53l0x_sim.h. Also provides the
+ * Arduino functions declared in Arduino.h.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "vl53l0x_sim.h"
+
+HardwareSerial Serial;
+TwoWire Wire;
+TwoWire Wire1;
+
+uint8_t sim_regs[2][256];
+uint8_t sim_address;
+unsigned long sim_now_us;
+unsigned long sim_range_us;
+double sim_spad_rate[48];
+double sim_noise;
+uint32_t sim_nvm[128];
+
+unsigned long sim_writes;
+unsigned long sim_reads;
+unsigned long sim_stops;
+unsigned long sim_bytes;
+unsigned long sim_ranges;
+
+static int page;
+static int regIndex = -1;
+static int readIndex;
+static bool nack;
+static bool pending;
+static bool continuous;
+static unsigned long rangeStart;
+static unsigned seed;
+
+/** Set up a sensor fresh out of reset, on the default address */
+void sim_reset(void) {
+  memset(sim_regs, 0, sizeof(sim_regs));
+  sim_regs[0][0xC0] = 0xEE; // IDENTIFICATION_MODEL_ID
+  sim_regs[0][0xC2] = 0x10; // IDENTIFICATION_REVISION_ID
+  sim_regs[0][0x0A] = 0x04; // SYSTEM_INTERRUPT_CONFIG_GPIO, new sample
+  sim_regs[0][0x91] = 0x3C; // stop variable
+  memset(sim_nvm, 0, sizeof(sim_nvm));
+  sim_nvm[0x24] = 0xFFFFFFFF; // every reference SPAD good
+  sim_nvm[0x25] = 0xFFFF0000;
+  sim_nvm[0x7B] = 0x12345678; // part UID
+  sim_nvm[0x7C] = 0x9ABCDEF0;
+  sim_address = 0x29;
+  sim_range_us = 5000;
+  for (int i = 0; i < 48; i++)
+    sim_spad_rate[i] = 2.0;
+  sim_noise = 0;
+  page = 0;
+  regIndex = -1;
+  pending = false;
+  continuous = false;
+  seed = 7;
+  sim_clear_counts();
+}
+
+/** Zero the transaction counters */
+void sim_clear_counts(void) {
+  sim_writes = 0;
+  sim_reads = 0;
+  sim_stops = 0;
+  sim_bytes = 0;
+  sim_ranges = 0;
+}
+
+static bool ready(void) {
+  return pending && ((sim_now_us - rangeStart) >= sim_range_us);
+}
+
+static void startRange(void) {
+  double rate = 0;
+  unsigned value;
+
+  pending = true;
+  rangeStart = sim_now_us;
+  sim_ranges++;
+
+  // the reference rate follows the SPADs enabled
+  for (int i = 0; i < 48; i++) {
+    if (sim_regs[0][0xB0 + i / 8] & (1 << (i % 8)))
+      rate += sim_spad_rate[i];
+  }
+  rate *= 1.0 + sim_noise * (2.0 * rand_r(&seed) / RAND_MAX - 1.0);
+  value = (unsigned)(rate * 128); // 9.7 fixed point
+  sim_regs[1][0xB6] = value >> 8;
+  sim_regs[1][0xB7] = value & 0xFF;
+
+  // 500 mm, 10 MCPS from 12 SPADs, status 11: range valid
+  sim_regs[0][0x16] = 0x0C; // effective SPAD return count, 8.8
+  sim_regs[0][0x1A] = 0x05; // signal rate, 9.7
+  sim_regs[0][0x1E] = 500 >> 8;
+  sim_regs[0][0x1F] = 500 & 0xFF;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  regIndex = -1;
+  sim_writes++;
+  sim_bytes++;
+  nack = (address != sim_address);
+}
+
+uint8_t TwoWire::endTransmission(bool stop) {
+  readIndex = regIndex;
+  if (stop)
+    sim_stops++;
+  return nack ? 2 : 0;
+}
+
+size_t TwoWire::write(uint8_t value) {
+  sim_now_us += 25;
+  sim_bytes++;
+  if (nack)
+    return 1;
+  if (regIndex < 0) {
+    regIndex = value;
+    return 1;
+  }
+
+  if (regIndex == 0xFF)
+    page = value ? 1 : 0;
+  sim_regs[page][regIndex & 0xFF] = value;
+
+  if (page == 0) {
+    switch (regIndex) {
+    case 0x00: // SYSRANGE_START
+      if (value & 0x07)
+        startRange();
+      else
+        pending = false;
+      continuous = (value & 0x06) != 0;
+      sim_regs[0][0x00] = 0; // the start bit clears itself
+      break;
+    case 0x0B: // SYSTEM_INTERRUPT_CLEAR
+      if (value) {
+        pending = false;
+        if (continuous)
+          startRange();
+      }
+      break;
+    case 0x8A: // I2C_SLAVE_DEVICE_ADDRESS
+      sim_address = value & 0x7F;
+      break;
+    }
+  }
+  if (regIndex == 0x94) {
+    // NVM read, the word shows up big endian at 0x90
+    uint32_t word = sim_nvm[value & 0x7F];
+    for (int i = 0; i < 4; i++)
+      sim_regs[page][0x90 + i] = word >> (24 - 8 * i);
+  }
+
+  regIndex++;
+  return 1;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t count, uint8_t) {
+  sim_reads++;
+  sim_bytes++;
+  nack = (address != sim_address);
+  return nack ? 0 : count;
+}
+
+int TwoWire::read(void) {
+  int reg = readIndex++ & 0xFF;
+
+  sim_now_us += 25;
+  sim_bytes++;
+  if (nack)
+    return -1;
+  if (page == 0) {
+    if (reg == 0x13) // RESULT_INTERRUPT_STATUS
+      return ready() ? 0x04 : 0x00;
+    if (reg == 0x14) // RESULT_RANGE_STATUS
+      return ready() ? ((11 << 3) | 0x01) : 0x00;
+  }
+  if ((reg == 0x83) && !sim_regs[page][0x83]) // NVM read ready
+    return 0x10;
+  return sim_regs[page][reg];
+}
+
+/* reading the clock takes a little time too, or a busy wait never ends */
+unsigned long millis(void) { return ++sim_now_us / 1000; }
+
+unsigned long micros(void) { return ++sim_now_us; }
+
+void delay(unsigned long ms) { sim_now_us += 1000 * ms; }
+
+void delayMicroseconds(unsigned int us) { sim_now_us += us; }
+
+void pinMode(uint8_t, uint8_t) {}
+
+void digitalWrite(uint8_t, uint8_t) {}
+
+/* every pin is GPIO1, low while a range is ready */
+int digitalRead(uint8_t) {
+  sim_now_us += 5;
+  return ready() ? LOW : HIGH;
+}
@@ -0,0 +1,54 @@
+/*!
+ * @file vl53l0x_sim.h
+ *
+ * Register model of one VL53L0X on a 400 kHz I2C bus, for running the
+ * library on a host in the benchmarks of extras/sim.
+ *
+ * The model is a plain register file with two pages (0xFF selects the page)
+ * and just enough behaviour for the library to go through its paths:
+ * - writing SYSRANGE_START starts a range that is ready sim_range_us later
+ * - clearing the interrupt ends it, and starts the next one in continuous
+ *   ranging
+ * - every range reports the reference signal rate of the SPADs enabled in
+ *   GLOBAL_CONFIG_SPAD_ENABLES_REF_0..5
+ * - the NVM holds a map with every reference SPAD good and a part UID
+ * - GPIO1 reads low while a range is ready
+ * - writing I2C_SLAVE_DEVICE_ADDRESS moves the device, other addresses are
+ *   not acknowledged
+ *
+ * Time moves 25 us per byte on the bus, with delay(), and 1 us per read of
+ * the clock. The busy loop of VL53L0X_PollingDelay() is not seen, so the
+ * PAL wait loops, which count polls, give up sooner than on a board. Ranges
+ * default to 5 ms for that reason.
+ *
+ * It is not a model of the ranging itself, only of what the library sees
+ * over I2C, so it is good for counting transfers and checking register
+ * images, not for judging ranges.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#ifndef VL53L0X_SIM_H
+#define VL53L0X_SIM_H
+
+#include "Wire.h"
+
+extern uint8_t sim_regs[2][256];   ///< page 0 and page 1 registers
+extern uint8_t sim_address;        ///< 7 bit address the device answers on
+extern unsigned long sim_now_us;   ///< simulated time
+extern unsigned long sim_range_us; ///< length of a range, 0 for instant
+extern double sim_spad_rate[48];   ///< reference rate of each SPAD, MCPS
+extern double sim_noise;           ///< relative noise on the reference rate
+extern uint32_t sim_nvm[128];      ///< NVM words, read through 0x94/0x90
+
+extern unsigned long sim_writes; ///< write transactions
+extern unsigned long sim_reads;  ///< read transactions
+extern unsigned long sim_stops;  ///< stops ending a write transaction
+extern unsigned long sim_bytes;  ///< bytes on the bus, addresses included
+extern unsigned long sim_ranges; ///< ranges started
+
+void sim_reset(void);
+void sim_clear_counts(void);
+
+#endif
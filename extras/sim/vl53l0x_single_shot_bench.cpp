@@ -0,0 +1,129 @@
+/*!
+ * @file vl53l0x_single_shot_bench.cpp
+ *
+ * Counts the I2C work per range of the single shot ranging functions of
+ * Adafruit_VL53L0X on the register model of vl53l0x_sim.cpp: transactions
+ * (writes and reads), stops ending a write, and bus time. That covers
+ * readRange(), readRangeFast() and reading and restarting ranges with and
+ * without readRangeResultAndRearm(), in single and continuous ranging.
+ * Ranges are ready at the first data ready poll, so the figures are the
+ * fixed cost of a range, without the polling. The
+ * vl53l0x_single_shot_benchmark example measures the same on a board.
+ *
+ * Build from the root of the library:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_single_shot_bench.cpp extras/sim/vl53l0x_sim.cpp \
+ *       src/Adafruit_VL53L0X.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_single_shot_bench
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X.h"
+#include "vl53l0x_sim.h"
+
+#define RANGES 100 ///< ranges per figure
+
+static unsigned long startTime;
+static unsigned long waited; ///< time spent in waitNextRange()
+
+static void startCount(void) {
+  sim_clear_counts();
+  startTime = sim_now_us;
+  waited = 0;
+}
+
+/** Host doing other work while the next continuous range integrates */
+static void waitNextRange(void) {
+  delay(5);
+  waited += 5000;
+}
+
+static void report(const char *name, Adafruit_VL53L0X *lox) {
+  printf("%-34s %5.2f transactions, %5.2f stops, %5.0f us bus time, "
+         "status %d\n",
+         name, (double)(sim_writes + sim_reads) / RANGES,
+         (double)sim_stops / RANGES,
+         (double)(sim_now_us - startTime - waited) / RANGES, lox->Status);
+}
+
+int main(void) {
+  Adafruit_VL53L0X lox;
+
+  sim_reset();
+  if (!lox.begin()) {
+    printf("begin() failed, status %d\n", lox.Status);
+    return 1;
+  }
+  sim_range_us = 0;
+
+  lox.readRange(); // the first one pays for the mode change
+  startCount();
+  for (int i = 0; i < RANGES; i++)
+    lox.readRange();
+  report("readRange()", &lox);
+
+  lox.readRangeFast();
+  startCount();
+  for (int i = 0; i < RANGES; i++)
+    lox.readRangeFast();
+  report("readRangeFast()", &lox);
+
+  lox.startRange();
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    lox.waitRangeComplete();
+    lox.readRangeResult();
+    lox.startRange();
+  }
+  report("readRangeResult() + startRange()", &lox);
+
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    lox.waitRangeComplete();
+    lox.readRangeResultAndRearm(true);
+  }
+  report("readRangeResultAndRearm(true)", &lox);
+
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    lox.waitRangeComplete();
+    lox.readRangeResultAndRearm(false);
+  }
+  report("readRangeResultAndRearm(false)", &lox);
+
+  // the next range takes a while after the clear, waited out with delay()
+  // so that no polls are counted
+  lox.waitRangeComplete();
+  lox.readRangeResult();
+  sim_range_us = 2000;
+  lox.startRangeContinuous();
+  printf("continuous:\n");
+
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    waitNextRange();
+    lox.readRangeResult();
+  }
+  report("readRangeResult()", &lox);
+
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    waitNextRange();
+    lox.readRangeResultAndRearm(true);
+  }
+  report("readRangeResultAndRearm(true)", &lox);
+
+  startCount();
+  for (int i = 0; i < RANGES; i++) {
+    waitNextRange();
+    lox.readRangeResultAndRearm(false);
+  }
+  report("readRangeResultAndRearm(false)", &lox);
+
+  lox.stopRangeContinuous();
+  return 0;
+}
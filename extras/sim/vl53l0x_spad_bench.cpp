@@ -0,0 +1,122 @@
+/*!
+ * @file vl53l0x_spad_bench.cpp
+ *
+ * Benchmark of the reference SPAD management on the register model of
+ * vl53l0x_sim.cpp. Each trial makes up a device: about one SPAD in eight
+ * is bad, non-aperture SPADs give 1 to 7 MCPS each and aperture SPADs a
+ * tenth to a fifth of that. It then runs
+ * VL53L0X_perform_ref_spad_management() and counts the reference
+ * measurements and the bytes on the bus. The optional noise is the relative
+ * error put on every reference rate measured.
+ *
+ *   vl53l0x_spad_bench [trials [noise [-v]]]
+ *
+ * prints the averages per calibration for the devices that ended on each
+ * SPAD type, and with -v one line per trial:
+ * trial, SPAD count, aperture, measurements, bytes.
+ *
+ * Build from the root of the library, add -DVL53L0X_REF_SPAD_LINEAR_SEARCH=1
+ * for the SPAD by SPAD walk to compare with:
+ *
+ *   g++ -std=gnu++11 -O1 -DARDUINO=100 -Iextras/sim -Isrc \
+ *       extras/sim/vl53l0x_spad_bench.cpp extras/sim/vl53l0x_sim.cpp \
+ *       $(ls src/core/src/[a-z]*.cpp src/platform/src/[a-z]*.cpp) \
+ *       -o vl53l0x_spad_bench
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "vl53l0x_api.h"
+#include "vl53l0x_api_calibration.h"
+#include "vl53l0x_sim.h"
+
+uint8_t is_aperture(uint32_t spadIndex); // in vl53l0x_api_calibration.cpp
+
+static VL53L0X_Dev_t dev;
+
+/** Reference rate of the SPADs left enabled, without the noise */
+static double enabledRate(void) {
+  double rate = 0;
+
+  for (int i = 0; i < 48; i++) {
+    if (sim_regs[0][0xB0 + i / 8] & (1 << (i % 8)))
+      rate += sim_spad_rate[i];
+  }
+  return rate;
+}
+
+int main(int argc, char **argv) {
+  int trials = (argc > 1) ? atoi(argv[1]) : 2000;
+  double noise = (argc > 2) ? atof(argv[2]) : 0;
+  bool verbose = (argc > 3);
+  // per SPAD type the search ended on, non-aperture then aperture
+  unsigned long bytes[2] = {0, 0}, measurements[2] = {0, 0};
+  unsigned long worst[2] = {0, 0};
+  int devices[2] = {0, 0};
+  double distance = 0;
+  int failures = 0;
+
+  srand(1);
+  for (int t = 0; t < trials; t++) {
+    uint32_t count = 0;
+    uint8_t aperture = 0;
+    VL53L0X_Error status;
+
+    sim_reset();
+    sim_range_us = 0;
+    sim_noise = noise;
+
+    memset(&dev, 0, sizeof(dev));
+    dev.I2cDevAddr = 0x29;
+    dev.i2c = &Wire;
+    dev.Data.SequenceConfig = 0xE8;
+    dev.Data.DeviceSpecificParameters.Pin0GpioFunctionality =
+        VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY;
+    dev.Data.targetRefRate = 0x0A00; // 20 MCPS
+
+    // about one bad SPAD in eight
+    for (int i = 0; i < 48; i++) {
+      if (rand() % 8)
+        dev.Data.SpadData.RefGoodSpadMap[i / 8] |= 1 << (i % 8);
+    }
+    // non-aperture 1 to 7 MCPS, aperture a tenth to a fifth of that
+    double normal = 1.0 + 6.0 * rand() / RAND_MAX;
+    double small = normal * (0.1 + 0.1 * rand() / RAND_MAX);
+    for (int i = 0; i < 48; i++) {
+      double base = is_aperture(0xB4 + i) ? small : normal;
+      sim_spad_rate[i] = base * (0.8 + 0.4 * rand() / RAND_MAX);
+    }
+
+    sim_clear_counts();
+    status = VL53L0X_perform_ref_spad_management(&dev, &count, &aperture);
+    if (status != VL53L0X_ERROR_NONE) {
+      failures++;
+      if (verbose)
+        printf("%d error %d\n", t, status);
+      continue;
+    }
+
+    aperture = aperture ? 1 : 0;
+    devices[aperture]++;
+    bytes[aperture] += sim_bytes;
+    measurements[aperture] += sim_ranges;
+    if (sim_ranges > worst[aperture])
+      worst[aperture] = sim_ranges;
+    distance += fabs(enabledRate() - 20.0);
+    if (verbose)
+      printf("%d %u %u %lu %lu\n", t, count, aperture, sim_ranges, sim_bytes);
+  }
+
+  for (int a = 0; a < 2; a++) {
+    if (devices[a] == 0)
+      continue;
+    printf("%-12s %5d devices: %5.2f measurements (max %2lu), %4.0f bytes\n",
+           a ? "aperture" : "non-aperture", devices[a],
+           (double)measurements[a] / devices[a], worst[a],
+           (double)bytes[a] / devices[a]);
+  }
+  printf("%d failed, mean |rate - 20| %.3f MCPS\n", failures,
+         (trials > failures) ? distance / (trials - failures) : 0);
+  return 0;
+}
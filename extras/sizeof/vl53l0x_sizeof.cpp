@@ -0,0 +1,65 @@
+/*!
+ * @file vl53l0x_sizeof.cpp
+ *
+ * Host side check of the RAM an Adafruit_VL53L0X object takes, in the
+ * configuration it is built with. Build and run it once per configuration
+ * from the root of the library:
+ *
+ *   g++ -DARDUINO=100 -DVL53L0X_SLIM=0 -Iextras/replay -Isrc \
+ *       extras/sizeof/vl53l0x_sizeof.cpp -o vl53l0x_sizeof && ./vl53l0x_sizeof
+ *   g++ -DARDUINO=100 -DVL53L0X_SLIM=1 -Iextras/replay -Isrc \
+ *       extras/sizeof/vl53l0x_sizeof.cpp -o vl53l0x_sizeof && ./vl53l0x_sizeof
+ *
+ * The sizes are printed, and on a 64-bit host it fails when the object
+ * outgrew the size recorded below for the configuration. Raise the limit
+ * when something is added on purpose, after checking it has to be in the
+ * object and can not be compiled out of the slim layout.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X.h"
+
+#include <stdio.h>
+
+TwoWire Wire;
+
+// sizeof(Adafruit_VL53L0X) on a 64-bit host. The slim layout measured 328
+// bytes when it went in. The features added since keep state in use while
+// ranging, which is why the limits moved up with them:
+//   PAL hooks for raw result capture and the data ready pin   +32
+//   budget controller                                         +32
+//   non-blocking stop                                         +28
+//   range events and the data ready pin                       +24
+//   resumable init, for the scheduler recovery                +15
+//   phase calibration cache                                   +15
+//   standby signature                                         +13
+//   GPIO polarity, SPAD write verify and prepared ranging     +8
+//   calibration state moved out, a pointer is left            -39
+// plus the padding between them.
+#if VL53L0X_SLIM
+#define SIZEOF_LIMIT 464
+#else
+#define SIZEOF_LIMIT 624
+#endif
+
+int main(void) {
+  size_t size = sizeof(Adafruit_VL53L0X);
+
+  printf("VL53L0X_SLIM=%d\n", VL53L0X_SLIM);
+  printf("  Adafruit_VL53L0X             %4u\n", (unsigned)size);
+  printf("    VL53L0X_Dev_t              %4u\n",
+         (unsigned)sizeof(VL53L0X_Dev_t));
+  printf("      VL53L0X_DevData_t        %4u\n",
+         (unsigned)sizeof(VL53L0X_DevData_t));
+  printf("  VL53L0X_CalibrationState_t   %4u%s\n",
+         (unsigned)sizeof(VL53L0X_CalibrationState_t),
+         VL53L0X_SLIM ? " (outside the object)" : "");
+
+  if ((sizeof(void *) == 8) && (size > SIZEOF_LIMIT)) {
+    printf("FAIL: larger than %u\n", SIZEOF_LIMIT);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Decode a VL53L0X I2C trace printed by Adafruit_VL53L0X::printI2CTrace().
+
+Build with VL53L0X_I2C_TRACE defined, call printI2CTrace() after the
+operation of interest and save the serial output. Then run
+
+    python3 vl53l0x_trace_decode.py capture.txt
+
+Every transaction is listed with its register name and the time since the
+previous one. Each ranging cycle found in the trace is then broken down into
+its phases: start, integration until the first ready poll, result readout
+and interrupt clear. Anything that is not a trace line is ignored, so the
+whole serial log can be passed in.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+WRITE, READ = 0, 1
+STATUS_SHORT = 0x80
+
+SYSRANGE_START = 0x00
+SYSTEM_INTERRUPT_CLEAR = 0x0B
+RESULT_INTERRUPT_STATUS = 0x13
+RESULT_RANGE_STATUS = 0x14
+PAGE_SELECT = 0xFF
+
+START_MODES = {0x00: "stop", 0x01: "single", 0x02: "back-to-back",
+               0x04: "timed"}
+
+WIRE_STATUS = {1: "data too long", 2: "address NACK", 3: "data NACK",
+               4: "bus error", 5: "timeout"}
+
+
+def load_register_names():
+    """Register names from vl53l0x_device.h, page 0 only."""
+    header = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..",
+                          "src", "vl53l0x_device.h")
+    names = {}
+    try:
+        with open(header) as f:
+            for line in f:
+                m = re.match(
+                    r"#define VL53L0X_REG_(\w+)\s+\(?(0x[0-9A-Fa-f]+)", line)
+                if m and int(m.group(2), 16) <= 0xFF:
+                    names.setdefault(int(m.group(2), 16), m.group(1))
+    except OSError:
+        pass
+    names[PAGE_SELECT] = "PAGE_SELECT"
+    return names
+
+
+class Record:
+    def __init__(self, line):
+        h = line.split()[1]
+        self.micros = int(h[0:8], 16)
+        self.duration = int(h[8:12], 16)
+        self.address = int(h[12:14], 16)
+        self.op = int(h[14:16], 16)
+        self.index = int(h[16:18], 16)
+        self.length = int(h[18:20], 16)
+        self.status = int(h[20:22], 16)
+        self.data = bytes.fromhex(h[22:30])[:min(self.length, 4)]
+        self.page = 0
+
+    @property
+    def end(self):
+        return self.micros + self.duration
+
+    def value(self):
+        v = 0
+        for b in self.data:
+            v = (v << 8) | b
+        return v
+
+
+def parse(lines):
+    records, header = [], None
+    for line in lines:
+        line = line.strip()
+        if line.startswith("VL53L0X trace ") and "end" not in line:
+            records, header = [], line
+        elif re.match(r"^T [0-9A-Fa-f]{30}$", line):
+            records.append(Record(line))
+    return header, records
+
+
+def describe(r, names):
+    name = names.get(r.index, "0x%02X" % r.index) if r.page == 0 else \
+        "page1 0x%02X" % r.index
+    data = " ".join("%02X" % b for b in r.data)
+    if r.length > len(r.data):
+        data += " .."
+    text = "%s %-36s %s" % ("W" if r.op == WRITE else "R", name, data)
+    if r.page == 0 and r.op == WRITE and r.index == SYSRANGE_START:
+        text += "  <start %s>" % START_MODES.get(r.value(), "?")
+    if r.status:
+        err = WIRE_STATUS.get(r.status & 0x7F, "")
+        if r.status & STATUS_SHORT:
+            err = (err + ", " if err else "") + "short read"
+        text += "  !! %s" % err
+    return text
+
+
+def track_pages(records):
+    page = {}
+    for r in records:
+        r.page = page.get(r.address, 0)
+        if r.op == WRITE and r.index == PAGE_SELECT and r.data:
+            page[r.address] = r.data[0]
+
+
+def cycles(records):
+    """Ranging cycles: a start on page 0 up to the interrupt clear after the
+    result was read."""
+    found, cur = [], None
+    for r in records:
+        if r.page != 0:
+            continue
+        if r.op == WRITE and r.index == SYSRANGE_START and r.data and \
+                r.data[0] in (0x01, 0x02, 0x04):
+            cur = {"address": r.address, "mode": START_MODES[r.data[0]],
+                   "start": r.micros, "polls": 0, "ready": None,
+                   "result": None, "clear": None, "busy": 0}
+            found.append(cur)
+        if cur is None or r.address != cur["address"]:
+            continue
+        cur["busy"] += r.duration
+        if r.op == READ and r.index == RESULT_INTERRUPT_STATUS:
+            cur["polls"] += 1
+            if cur["ready"] is None and r.data and r.data[0] & 0x07:
+                cur["ready"] = r.end
+        elif r.op == READ and r.index == RESULT_RANGE_STATUS:
+            cur["result"] = r.end
+            if cur["ready"] is None:
+                cur["ready"] = r.micros
+        elif r.op == WRITE and r.index == SYSTEM_INTERRUPT_CLEAR and \
+                cur["result"] is not None:
+            cur["clear"] = r.end
+            if cur["mode"] == "single":
+                cur = None
+            else:
+                # continuous modes roll over to the next range on their own
+                cur = dict(cur, start=r.end, polls=0, ready=None,
+                           result=None, clear=None, busy=0)
+                found.append(cur)
+        elif r.op == WRITE and r.index == SYSRANGE_START and r.data and \
+                r.data[0] == 0x00:
+            if cur["result"] is None:
+                found.remove(cur)
+            cur = None
+    return found
+
+
+def span(a, b):
+    if a is None or b is None:
+        return "       -"
+    return "%8d" % ((b - a) & 0xFFFFFFFF)  # micros() wraps
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("capture", nargs="?", help="serial log, stdin if omitted")
+    ap.add_argument("-q", "--quiet", action="store_true",
+                    help="only print the phase summary")
+    args = ap.parse_args()
+
+    lines = open(args.capture) if args.capture else sys.stdin
+    header, records = parse(lines)
+    if not records:
+        sys.exit("no trace lines found")
+
+    names = load_register_names()
+    track_pages(records)
+    t0 = records[0].micros
+
+    if header:
+        print(header)
+    if not args.quiet:
+        print("%10s %7s %5s  %s" % ("t [us]", "gap", "dur", "transaction"))
+        prev = None
+        for r in records:
+            gap = (r.micros - prev.end) & 0xFFFFFFFF if prev else 0
+            print("%10d %7d %5d  %02X %s" % ((r.micros - t0) & 0xFFFFFFFF,
+                                             gap, r.duration, r.address,
+                                             describe(r, names)))
+            prev = r
+        print()
+
+    busy = sum(r.duration for r in records)
+    errors = sum(1 for r in records if r.status)
+    elapsed = (records[-1].end - t0) & 0xFFFFFFFF
+    print("%d transactions over %d us, I2C busy %d us (%.1f%%), %d errors" %
+          (len(records), elapsed, busy, 100.0 * busy / max(elapsed, 1),
+           errors))
+
+    found = cycles(records)
+    if found:
+        print()
+        print("addr mode          polls  start>ready ready>result "
+              "result>clear   total  i2c busy")
+        for c in found:
+            print("  %02X %-13s %5d %12s %12s %12s %7s %9d" % (
+                c["address"], c["mode"], c["polls"],
+                span(c["start"], c["ready"]), span(c["ready"], c["result"]),
+                span(c["result"], c["clear"]),
+                span(c["start"], c["clear"]), c["busy"]))
+
+
+if __name__ == "__main__":
+    main()
@@ -33,6 +33,7 @@
  */
 
 #include "Adafruit_VL53L0X.h"
+#include "vl53l0x_api_calibration.h"
 #include "vl53l0x_api_core.h"
 
 #define VERSION_REQUIRED_MAJOR 1 ///< Required sensor major version
@@ -42,6 +43,11 @@
 #define STR_HELPER(x) #x     ///< a string helper
 #define STR(x) STR_HELPER(x) ///< string helper wrapper
 
+#if VL53L0X_SLIM
+VL53L0X_CalibrationState_t Adafruit_VL53L0X::_calShared = {};
+Adafruit_VL53L0X *Adafruit_VL53L0X::_calOwner = NULL;
+#endif
+
 /**************************************************************************/
 /*!
     @brief  Setups the I2C interface and hardware
@@ -61,76 +67,10 @@ boolean Adafruit_VL53L0X::begin(uint8_t i2c_addr, boolean debug, TwoWire *i2c,
   uint8_t VhvSettings;
   uint8_t PhaseCal;
 
-  // Initialize Comms
-  pMyDevice->I2cDevAddr = VL53L0X_I2C_ADDR; // default
-  pMyDevice->comms_type = 1;
-  pMyDevice->comms_speed_khz = 400;
-  pMyDevice->i2c = i2c;
-
-  pMyDevice->i2c->begin(); // VL53L0X_i2c_init();
-
-  // unclear if this is even needed:
-  if (VL53L0X_IMPLEMENTATION_VER_MAJOR != VERSION_REQUIRED_MAJOR ||
-      VL53L0X_IMPLEMENTATION_VER_MINOR != VERSION_REQUIRED_MINOR ||
-      VL53L0X_IMPLEMENTATION_VER_SUB != VERSION_REQUIRED_BUILD) {
-    if (debug) {
-      Serial.println(F(
-          "Found " STR(VL53L0X_IMPLEMENTATION_VER_MAJOR) "." STR(VL53L0X_IMPLEMENTATION_VER_MINOR) "." STR(
-              VL53L0X_IMPLEMENTATION_VER_SUB) " rev " STR(VL53L0X_IMPLEMENTATION_VER_REVISION)));
-      Serial.println(F("Requires " STR(VERSION_REQUIRED_MAJOR) "." STR(
-          VERSION_REQUIRED_MINOR) "." STR(VERSION_REQUIRED_BUILD)));
-    }
-
-    Status = VL53L0X_ERROR_NOT_SUPPORTED;
-
+  if (!initSensor(i2c_addr, debug, i2c)) {
     return false;
   }
 
-  Status = VL53L0X_DataInit(&MyDevice); // Data initialization
-
-  if (!setAddress(i2c_addr)) {
-    return false;
-  }
-
-  Status = VL53L0X_GetDeviceInfo(&MyDevice, &DeviceInfo);
-
-  if (Status == VL53L0X_ERROR_NONE) {
-    if (debug) {
-      Serial.println(F("VL53L0X Info:"));
-      Serial.print(F("Device Name: "));
-      Serial.print(DeviceInfo.Name);
-      Serial.print(F(", Type: "));
-      Serial.print(DeviceInfo.Type);
-      Serial.print(F(", ID: "));
-      Serial.println(DeviceInfo.ProductId);
-
-      Serial.print(F("Rev Major: "));
-      Serial.print(DeviceInfo.ProductRevisionMajor);
-      Serial.print(F(", Minor: "));
-      Serial.println(DeviceInfo.ProductRevisionMinor);
-    }
-
-    if ((DeviceInfo.ProductRevisionMajor != 1) ||
-        (DeviceInfo.ProductRevisionMinor != 1)) {
-      if (debug) {
-        Serial.print(F("Error expected cut 1.1 but found "));
-        Serial.print(DeviceInfo.ProductRevisionMajor);
-        Serial.print(',');
-        Serial.println(DeviceInfo.ProductRevisionMinor);
-      }
-
-      Status = VL53L0X_ERROR_NOT_SUPPORTED;
-    }
-  }
-
-  if (Status == VL53L0X_ERROR_NONE) {
-    if (debug) {
-      Serial.println(F("VL53L0X: StaticInit"));
-    }
-
-    Status = VL53L0X_StaticInit(pMyDevice); // Device Initialization
-  }
-
   if (Status == VL53L0X_ERROR_NONE) {
     if (debug) {
       Serial.println(F("VL53L0X: PerformRefSpadManagement"));
@@ -184,6 +124,234 @@ boolean Adafruit_VL53L0X::begin(uint8_t i2c_addr, boolean debug, TwoWire *i2c,
   }
 }
 
+/**************************************************************************/
+/*!
+    @brief  First half of begin(): sets up the I2C interface, moves the sensor
+   to its new address and runs the data and static initialization. Follow it
+   with startCalibration() and calibrationStep() then configSensor(), which
+   lets the calibration of several sensors overlap
+    @param  i2c_addr Optional I2C address the sensor can be found on. Default is
+   0x29
+    @param debug Optional debug flag. If true, debug information will print out
+   via Serial.print during setup. Defaults to false.
+    @param  i2c Optional I2C bus the sensor is located on. Default is Wire
+    @returns True if device is initialized, false on any failure
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::initSensor(uint8_t i2c_addr, boolean debug,
+                                     TwoWire *i2c) {
+  if (!startInit(i2c_addr, debug, i2c)) {
+    return false;
+  }
+
+  while (!initStep()) {
+  }
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start an initSensor() that runs a few milliseconds at a time,
+   call initStep() until it returns true. Does not access the sensor
+    @param  i2c_addr Optional I2C address the sensor can be found on. Default is
+   0x29
+    @param debug Optional debug flag. If true, debug information will print out
+   via Serial.print during the steps. Defaults to false.
+    @param  i2c Optional I2C bus the sensor is located on. Default is Wire
+    @returns True if the init was started, false on any failure
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::startInit(uint8_t i2c_addr, boolean debug,
+                                    TwoWire *i2c) {
+  // Initialize Comms
+  pMyDevice->I2cDevAddr = VL53L0X_I2C_ADDR; // default
+  pMyDevice->comms_type = 1;
+  pMyDevice->comms_speed_khz = 400;
+  pMyDevice->i2c = i2c;
+
+  pMyDevice->i2c->begin(); // VL53L0X_i2c_init();
+
+  _initStep = INIT_DONE;
+
+  // unclear if this is even needed:
+  if (VL53L0X_IMPLEMENTATION_VER_MAJOR != VERSION_REQUIRED_MAJOR ||
+      VL53L0X_IMPLEMENTATION_VER_MINOR != VERSION_REQUIRED_MINOR ||
+      VL53L0X_IMPLEMENTATION_VER_SUB != VERSION_REQUIRED_BUILD) {
+    if (debug) {
+      Serial.println(F(
+          "Found " STR(VL53L0X_IMPLEMENTATION_VER_MAJOR) "." STR(VL53L0X_IMPLEMENTATION_VER_MINOR) "." STR(
+              VL53L0X_IMPLEMENTATION_VER_SUB) " rev " STR(VL53L0X_IMPLEMENTATION_VER_REVISION)));
+      Serial.println(F("Requires " STR(VERSION_REQUIRED_MAJOR) "." STR(
+          VERSION_REQUIRED_MINOR) "." STR(VERSION_REQUIRED_BUILD)));
+    }
+
+    Status = VL53L0X_ERROR_NOT_SUPPORTED;
+
+    return false;
+  }
+
+  Status = VL53L0X_ERROR_NONE;
+  _initAddr = i2c_addr & 0x7F;
+  _initDebug = debug;
+  _initStep = INIT_DATA;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Run the next step of the init begun with startInit(). A step is
+   at most a few milliseconds of I2C, unless the NVM holds no valid
+   reference SPADs and they have to be found with measurements
+    @returns True once the init is over, Status then tells how it went.
+   False if there are steps left
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::initStep(void) {
+  VL53L0X_DeviceInfo_t DeviceInfo; // only needed here, keep it off the object
+  uint8_t model_id;
+
+  switch (_initStep) {
+  case INIT_DATA:
+    // A sensor that kept its address over a reset of the host does not answer
+    // on the default one anymore, carry on where it is
+    if ((_initAddr != VL53L0X_I2C_ADDR) &&
+        (VL53L0X_RdByte(pMyDevice, VL53L0X_REG_IDENTIFICATION_MODEL_ID,
+                        &model_id) != VL53L0X_ERROR_NONE)) {
+      pMyDevice->I2cDevAddr = _initAddr;
+    }
+
+    Status = VL53L0X_DataInit(&MyDevice); // Data initialization
+    if (Status != VL53L0X_ERROR_NONE) {
+      break;
+    }
+
+    if (pMyDevice->I2cDevAddr != _initAddr) {
+      Status = VL53L0X_SetDeviceAddress(pMyDevice, _initAddr * 2); // 7->8 bit
+      if (Status != VL53L0X_ERROR_NONE) {
+        break;
+      }
+      pMyDevice->I2cDevAddr = _initAddr;
+      _initTime = millis();
+      _initStep = INIT_ADDRESS;
+      return false;
+    }
+
+    _initStep = INIT_INFO;
+    return false;
+
+  case INIT_ADDRESS:
+    // give the sensor the same time on its new address as setAddress() does
+    if ((millis() - _initTime) < 10) {
+      return false;
+    }
+
+    _initStep = INIT_INFO;
+    return false;
+
+  case INIT_INFO:
+    if ((_nvmInfo != NULL) && _nvmInfo->Valid) {
+      uint32_t uid_upper = _nvmInfo->PartUIDUpper;
+      uint32_t uid_lower = _nvmInfo->PartUIDLower;
+
+      if (_nvmVerify) {
+        Status = VL53L0X_get_part_uid(pMyDevice, &uid_upper, &uid_lower);
+      }
+      if ((Status == VL53L0X_ERROR_NONE) &&
+          (uid_upper == _nvmInfo->PartUIDUpper) &&
+          (uid_lower == _nvmInfo->PartUIDLower)) {
+        if (_initDebug) {
+          Serial.println(F("VL53L0X: using cached NVM info"));
+        }
+        Status = VL53L0X_set_nvm_info(pMyDevice, _nvmInfo);
+        if (Status == VL53L0X_ERROR_INVALID_PARAMS) {
+          // corrupt image, read the NVM and replace it below
+          _nvmInfo->Valid = 0;
+          Status = VL53L0X_ERROR_NONE;
+        }
+      } else {
+        // another part, read its NVM and replace the cache below
+        _nvmInfo->Valid = 0;
+      }
+    }
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetDeviceInfo(&MyDevice, &DeviceInfo);
+    }
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      if (_initDebug) {
+        Serial.println(F("VL53L0X Info:"));
+        Serial.print(F("Device Name: "));
+        Serial.print(DeviceInfo.Name);
+        Serial.print(F(", Type: "));
+        Serial.print(DeviceInfo.Type);
+        Serial.print(F(", ID: "));
+        Serial.println(DeviceInfo.ProductId);
+
+        Serial.print(F("Rev Major: "));
+        Serial.print(DeviceInfo.ProductRevisionMajor);
+        Serial.print(F(", Minor: "));
+        Serial.println(DeviceInfo.ProductRevisionMinor);
+      }
+
+      if ((DeviceInfo.ProductRevisionMajor != 1) ||
+          (DeviceInfo.ProductRevisionMinor != 1)) {
+        if (_initDebug) {
+          Serial.print(F("Error expected cut 1.1 but found "));
+          Serial.print(DeviceInfo.ProductRevisionMajor);
+          Serial.print(',');
+          Serial.println(DeviceInfo.ProductRevisionMinor);
+        }
+
+        Status = VL53L0X_ERROR_NOT_SUPPORTED;
+      }
+    }
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      if (_initDebug) {
+        Serial.println(F("VL53L0X: StaticInit"));
+      }
+
+      _initState.Step = VL53L0X_INITSTEP_NVM;
+      _initStep = INIT_STATIC;
+      return false;
+    }
+    break;
+
+  case INIT_STATIC:
+    Status = VL53L0X_StaticInitStep(pMyDevice, &_initState); // Device Init
+
+    if ((Status == VL53L0X_ERROR_NONE) &&
+        (_initState.Step != VL53L0X_INITSTEP_DONE)) {
+      return false;
+    }
+
+    if ((Status == VL53L0X_ERROR_NONE) && (_nvmInfo != NULL) &&
+        !_nvmInfo->Valid) {
+      _initStep = INIT_CACHE;
+      return false;
+    }
+    break;
+
+  case INIT_CACHE:
+    Status = VL53L0X_get_nvm_info(pMyDevice, _nvmInfo);
+    break;
+
+  default: // INIT_DONE
+    return true;
+  }
+
+  _initStep = INIT_DONE;
+
+  if ((Status != VL53L0X_ERROR_NONE) && _initDebug) {
+    Serial.print(F("VL53L0X Error: "));
+    Serial.println(Status);
+  }
+
+  return true;
+}
+
 /**************************************************************************/
 /*!
     @brief  Change the I2C address of the sensor
@@ -205,6 +373,330 @@ boolean Adafruit_VL53L0X::setAddress(uint8_t newAddr) {
   return false;
 }
 
+/**************************************************************************/
+/*!
+    @brief  Give the sensor a place to keep what it read from its NVM. The
+   next begin() or initSensor() fills it in, the ones after that take the
+   values from it instead of reading the NVM again. Store it in EEPROM to
+   keep it over power cycles, it is keyed by the part UID
+    @param  info The cache, set Valid to 0 to have it filled. NULL to stop
+   using a cache
+    @param  verify Read the part UID (two NVM reads instead of about
+   sixteen) to make sure the cache belongs to this sensor. Only turn this
+   off when the sensor can not be swapped
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::setNvmCache(VL53L0X_NvmInfo_t *info, boolean verify) {
+  _nvmInfo = info;
+  _nvmVerify = verify;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Choose when the reference SPAD map is read back after it is
+   written during calibration. Reading it back doubles the I2C traffic of
+   the map updates, which a clean bus does not need
+    @param  policy VL53L0X_VERIFY_ALWAYS (the default), VL53L0X_VERIFY_FIRST
+   to stop once a write verified, or VL53L0X_VERIFY_NEVER
+    @returns True if the policy is known
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::setVerifyPolicy(VL53L0X_VerifyPolicy policy) {
+  Status = VL53L0X_SetVerifyPolicy(pMyDevice, policy);
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Number of writes that did not read back what was written. Each
+   one also failed the calibration it was part of
+    @returns Failure count since the object was created
+*/
+/**************************************************************************/
+uint16_t Adafruit_VL53L0X::getVerifyFailures(void) {
+  uint16_t failures = 0;
+
+  Status = VL53L0X_GetVerifyFailCount(pMyDevice, &failures);
+  return failures;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Save what resume() needs to pick the sensor up again after the
+   host was reset but the sensor stayed powered. Call it once the sensor is
+   configured and idle, then keep the image somewhere that survives the
+   reset, EEPROM or a no-init RAM section
+    @param  image Where to store the state
+    @returns True if the image is valid
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::saveState(VL53L0X_ResumeImage_t *image) {
+  image->magic = 0;
+
+  Status = VL53L0X_get_device_signature(pMyDevice, &image->signature);
+
+  if (Status != VL53L0X_ERROR_NONE)
+    return false;
+
+  // the register is cleared by every stop sequence, keep the real value
+  image->signature.StopVariable = PALDevDataGet(pMyDevice, StopVariable);
+  if (image->signature.StopVariable == 0x00) {
+    // not initialized, resume() would refuse it
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+    return false;
+  }
+  memcpy(&image->data, &pMyDevice->Data, sizeof(VL53L0X_DevData_t));
+  image->magic = VL53L0X_RESUME_MAGIC;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Take over a sensor that is still set up from before a host reset,
+   instead of begin(). Only a handful of registers are read to check that
+   the sensor kept its state, the driver state then comes from the image.
+   When it returns false the sensor was power cycled or changed, use begin()
+    @param  image State stored by saveState()
+    @param  i2c_addr I2C address the sensor was moved to before the reset
+    @param debug Optional debug flag. If true, debug information will print out
+   via Serial.print. Defaults to false.
+    @param  i2c I2C bus the sensor is located on. Default is Wire
+    @returns True if the sensor is ready to range
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::resume(const VL53L0X_ResumeImage_t *image,
+                                 uint8_t i2c_addr, boolean debug,
+                                 TwoWire *i2c) {
+  VL53L0X_DeviceSignature_t signature;
+
+  pMyDevice->I2cDevAddr = i2c_addr & 0x7F;
+  pMyDevice->comms_type = 1;
+  pMyDevice->comms_speed_khz = 400;
+  pMyDevice->i2c = i2c;
+
+  pMyDevice->i2c->begin();
+
+  // a booted device never has a zero stop variable, and restoring one would
+  // break the stop sequence
+  if ((image->magic != VL53L0X_RESUME_MAGIC) ||
+      (image->signature.StopVariable == 0x00) ||
+      (image->data.StopVariable == 0x00)) {
+    if (debug) {
+      Serial.println(F("VL53L0X: no resume image"));
+    }
+    Status = VL53L0X_ERROR_NOT_SUPPORTED;
+    return false;
+  }
+
+  Status = VL53L0X_get_device_signature(pMyDevice, &signature);
+  if (signature.StopVariable == 0x00) {
+    // zeroed by a stop sequence since, that does not mean it lost its state
+    signature.StopVariable = image->signature.StopVariable;
+  }
+
+  if ((Status == VL53L0X_ERROR_NONE) &&
+      memcmp(&signature, &image->signature, sizeof(signature))) {
+    if (debug) {
+      Serial.println(F("VL53L0X: device state lost, need begin()"));
+    }
+    Status = VL53L0X_ERROR_NOT_SUPPORTED;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    memcpy(&pMyDevice->Data, &image->data, sizeof(VL53L0X_DevData_t));
+
+    // the reset may have hit in the middle of a measurement
+    Status = VL53L0X_StopMeasurement(pMyDevice);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status = VL53L0X_ClearInterruptMask(pMyDevice, 0);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    PALDevDataSet(pMyDevice, PalState, VL53L0X_STATE_IDLE);
+  } else if (debug) {
+    Serial.print(F("VL53L0X Error: "));
+    Serial.println(Status);
+  }
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start the reference SPAD management and reference calibration
+   that begin() runs, without waiting for them. Call calibrationStep() until
+   it returns true. The sensor must not be ranging
+    @param  ref_spads False to only redo the VHV and phase calibration, which
+   drift with temperature, and keep the reference SPADs
+    @returns True if the calibration could be started. With VL53L0X_SLIM
+   and no setCalibrationScratch(), false while another sensor calibrates
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::startCalibration(boolean ref_spads) {
+  VL53L0X_CalibrationState_t *state;
+
+#if VL53L0X_SLIM
+  if (_calScratch == NULL) {
+    if ((_calOwner != NULL) && (_calOwner != this) &&
+        (_calShared.Step != VL53L0X_CALSTEP_DONE)) {
+      // another sensor is calibrating in the shared scratch
+      Status = VL53L0X_ERROR_BUFFER_TOO_SMALL;
+      return false;
+    }
+    _calOwner = this;
+  }
+#endif
+  state = calibrationState();
+  VL53L0X_calibration_init(state, ref_spads ? VL53L0X_CALSTEP_SPAD_START
+                                            : VL53L0X_CALSTEP_REF_START);
+  _calRefPending = ref_spads;
+  Status = VL53L0X_ERROR_NONE;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Run the next step of a calibration started with
+   startCalibration(). A step never waits for the sensor, when the sensor is
+   still measuring it returns right away so other sensors can be serviced
+    @returns True once the calibration is over, check Status for the outcome
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::calibrationStep(void) {
+  VL53L0X_CalibrationState_t *state = calibrationState();
+
+  if ((state == NULL) || (state->Step == VL53L0X_CALSTEP_DONE))
+    return true;
+
+  Status = VL53L0X_calibration_step(pMyDevice, state);
+
+  if (Status != VL53L0X_ERROR_NONE) {
+    state->Step = VL53L0X_CALSTEP_DONE;
+    return true;
+  }
+
+  if (state->Step != VL53L0X_CALSTEP_DONE)
+    return false;
+
+  if (_calRefPending) {
+    // ref SPADs are set, now the same ref calibration begin() does
+    _calRefPending = false;
+    VL53L0X_calibration_init(state, VL53L0X_CALSTEP_REF_START);
+    return false;
+  }
+
+  // phase calibrations kept for other VCSEL periods are stale now
+  memset(_phaseCal, 0, sizeof(_phaseCal));
+
+  Status = VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Give up on a calibration started with startCalibration(), for
+   one that stopped making progress. Status is set to
+   VL53L0X_ERROR_TIME_OUT and, with VL53L0X_SLIM, the shared scratch is
+   free for the other sensors again. The sensor needs a new calibration,
+   or a new begin() if it stopped answering
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::abortCalibration(void) {
+  VL53L0X_CalibrationState_t *state = calibrationState();
+
+  if ((state != NULL) && (state->Step != VL53L0X_CALSTEP_DONE)) {
+    state->Step = VL53L0X_CALSTEP_DONE;
+    Status = VL53L0X_ERROR_TIME_OUT;
+  }
+  _calRefPending = false;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Give the sensor a place to keep the progress of its calibration.
+   Only used with VL53L0X_SLIM, where the object does not carry it. Without
+   one, all sensors share a single scratch and startCalibration() fails
+   while another sensor is still calibrating in it
+    @param  scratch Where to keep it, must stay valid until calibrationStep()
+   returns true. NULL to go back to the shared one
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::setCalibrationScratch(
+    VL53L0X_CalibrationState_t *scratch) {
+#if VL53L0X_SLIM
+  _calScratch = scratch;
+#else
+  (void)scratch;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Where the calibration of this sensor keeps its progress
+    @returns The state, NULL if this sensor lost the shared scratch
+*/
+/**************************************************************************/
+VL53L0X_CalibrationState_t *Adafruit_VL53L0X::calibrationState(void) {
+#if VL53L0X_SLIM
+  if (_calScratch != NULL)
+    return _calScratch;
+  return (_calOwner == this) ? &_calShared : NULL;
+#else
+  return &_calState;
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get what the reference SPAD management and reference calibration
+   of begin() or startCalibration() came up with
+    @param  cal Where to store it
+    @returns True if success
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::getRefCalibration(VL53L0X_RefCalibration_t *cal) {
+  Status = VL53L0X_GetReferenceSpads(pMyDevice, &cal->refSpadCount,
+                                     &cal->isApertureSpads);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_GetRefCalibration(pMyDevice, &cal->vhvSettings,
+                                       &cal->phaseCal);
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Apply a calibration saved with getRefCalibration() instead of
+   running one, after initSensor(). Takes a few register writes where the
+   calibration takes several ranges. Only valid for the same sensor at about
+   the same temperature
+    @param  cal The saved calibration
+    @returns True if success
+*/
+/**************************************************************************/
+boolean
+Adafruit_VL53L0X::setRefCalibration(const VL53L0X_RefCalibration_t *cal) {
+  Status = VL53L0X_SetReferenceSpads(pMyDevice, cal->refSpadCount,
+                                     cal->isApertureSpads);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status =
+        VL53L0X_SetRefCalibration(pMyDevice, cal->vhvSettings, cal->phaseCal);
+
+  // phase calibrations kept for other VCSEL periods may not match anymore
+  memset(_phaseCal, 0, sizeof(_phaseCal));
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status =
+        VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
 /**************************************************************************/
 /*!
     @brief  Configure the sensor for one of the ways the example ST
@@ -214,13 +706,17 @@ boolean Adafruit_VL53L0X::setAddress(uint8_t newAddr) {
         VL53L0X_SENSE_DEFAULT
         VL53L0X_SENSE_LONG_RANGE
         VL53L0X_SENSE_HIGH_SPEED,
-        VL53L0X_SENSE_HIGH_ACCURACY
+        VL53L0X_SENSE_HIGH_ACCURACY,
+        VL53L0X_SENSE_ULTRA_FAST
+    Only VL53L0X_SENSE_ULTRA_FAST changes the sequence steps, the others
+    leave them as they are
 
     @returns True if address was set successfully, False otherwise
 */
 /**************************************************************************/
 boolean Adafruit_VL53L0X::configSensor(VL53L0X_Sense_config_t vl_config) {
   // All of them appear to configure a few things
+  _budgetPlanned = false;
 
   // Serial.print(F("VL53L0X: configSensor "));
   // Serial.println((int)vl_config, DEC);
@@ -293,28 +789,258 @@ boolean Adafruit_VL53L0X::configSensor(VL53L0X_Sense_config_t vl_config) {
     // increase timing budget to 200 ms
 
     if (Status == VL53L0X_ERROR_NONE) {
-      setLimitCheckValue(VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
-                         (FixPoint1616_t)(0.25 * 65536));
-    }
-    if (Status == VL53L0X_ERROR_NONE) {
-      setLimitCheckValue(VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
-                         (FixPoint1616_t)(18 * 65536));
-    }
-    if (Status == VL53L0X_ERROR_NONE) {
-      setMeasurementTimingBudgetMicroSeconds(200000);
-    }
-    // Not sure about ignore threshold, try turnning it off...
-    if (Status == VL53L0X_ERROR_NONE) {
-      Status = VL53L0X_SetLimitCheckEnable(
-          pMyDevice, VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD, 0);
+      setLimitCheckValue(VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
+                         (FixPoint1616_t)(0.25 * 65536));
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setLimitCheckValue(VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
+                         (FixPoint1616_t)(18 * 65536));
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setMeasurementTimingBudgetMicroSeconds(200000);
+    }
+    // Not sure about ignore threshold, try turnning it off...
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_SetLimitCheckEnable(
+          pMyDevice, VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD, 0);
+    }
+
+    break;
+  case VL53L0X_SENSE_ULTRA_FAST:
+    // Close range at the highest rate: only DSS, which keeps a near target
+    // from saturating the SPADs, and the final range are left, so all of
+    // the shortest budget goes to the final range
+    Status = VL53L0X_SetLimitCheckValue(
+        pMyDevice, VL53L0X_CHECKENABLE_SIGNAL_RATE_FINAL_RANGE,
+        (FixPoint1616_t)(0.25 * 65536));
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_SetLimitCheckValue(pMyDevice,
+                                          VL53L0X_CHECKENABLE_SIGMA_FINAL_RANGE,
+                                          (FixPoint1616_t)(32 * 65536));
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setSequenceStepEnable(VL53L0X_SEQUENCESTEP_TCC, false);
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setSequenceStepEnable(VL53L0X_SEQUENCESTEP_MSRC, false);
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setSequenceStepEnable(VL53L0X_SEQUENCESTEP_PRE_RANGE, false);
+    }
+    if (Status == VL53L0X_ERROR_NONE) {
+      setMeasurementTimingBudgetMicroSeconds(
+          getMinimumTimingBudgetMicroSeconds());
+    }
+    break;
+  }
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Work out a configuration once, VCSEL phase calibration included,
+   and keep the result so applyProfile() can switch to it later with a few
+   register writes. The sensor is left as it was, so compile all profiles
+   from the same starting point, usually right after begin()
+    @param  vl_config Configuration to compile, as for configSensor()
+    @param  profile Where to store the result
+    @returns True if the profile was compiled
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::compileProfile(VL53L0X_Sense_config_t vl_config,
+                                         VL53L0X_Profile_t *profile) {
+  VL53L0X_Profile_t compiled;
+  VL53L0X_Error restore_status;
+
+  // profile holds the starting point until we are done
+  Status = VL53L0X_capture_profile(pMyDevice, profile);
+  if (Status != VL53L0X_ERROR_NONE) {
+    profile->Valid = 0;
+    return false;
+  }
+
+  if (configSensor(vl_config)) {
+    Status = VL53L0X_capture_profile(pMyDevice, &compiled);
+  }
+
+  // put the starting point back even if configSensor() stopped halfway,
+  // and report the first error
+  restore_status = VL53L0X_apply_profile(pMyDevice, profile);
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status = restore_status;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    memcpy(profile, &compiled, sizeof(compiled));
+  } else {
+    profile->Valid = 0;
+  }
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Switch to a profile made by compileProfile() or built with
+   Adafruit_VL53L0X_Profile::build(). No calibration measurement is done,
+   so this is much faster than configSensor(). A built profile has no phase
+   calibration, the first time its VCSEL periods are applied one is run and
+   kept for next time. The sensor must not be ranging
+    @param  profile The profile
+    @returns True if the profile was applied
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::applyProfile(const VL53L0X_Profile_t *profile) {
+  phasecal_entry_t *entry;
+  uint8_t vhv_settings;
+  uint8_t phase_cal;
+
+  _budgetPlanned = false;
+  Status = VL53L0X_apply_profile(pMyDevice, profile);
+  if (Status != VL53L0X_ERROR_NONE)
+    return false;
+
+  if (profile->Valid == VL53L0X_PROFILE_CAPTURED) {
+    entry = findPhaseCal(profile->PreRangeVcselPulsePeriod,
+                         profile->FinalRangeVcselPulsePeriod, true);
+    entry->phaseCal = profile->PhaseCal;
+    return true;
+  }
+
+  entry = findPhaseCal(profile->PreRangeVcselPulsePeriod,
+                       profile->FinalRangeVcselPulsePeriod, false);
+  if (entry != NULL) {
+    Status = VL53L0X_ref_calibration_io(pMyDevice, 0, 0, entry->phaseCal,
+                                        &vhv_settings, &phase_cal, 0, 1);
+  } else {
+    Status = VL53L0X_perform_phase_calibration(pMyDevice, &phase_cal, 1, 1);
+    if (Status == VL53L0X_ERROR_NONE) {
+      entry = findPhaseCal(profile->PreRangeVcselPulsePeriod,
+                           profile->FinalRangeVcselPulsePeriod, true);
+      entry->phaseCal = phase_cal;
     }
-
-    break;
   }
 
   return (Status == VL53L0X_ERROR_NONE);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Look up the phase calibration kept for a pair of VCSEL periods
+    @param  pre_vcsel Pre-range VCSEL period
+    @param  final_vcsel Final range VCSEL period
+    @param  add If true and the pair is not there, take over the oldest entry
+    @returns The entry, NULL if not found and add is false
+*/
+/**************************************************************************/
+Adafruit_VL53L0X::phasecal_entry_t *
+Adafruit_VL53L0X::findPhaseCal(uint8_t pre_vcsel, uint8_t final_vcsel,
+                               boolean add) {
+  phasecal_entry_t *entry;
+
+  for (uint8_t i = 0; i < VL53L0X_PHASECAL_CACHE_SIZE; i++) {
+    if ((_phaseCal[i].preVcsel == pre_vcsel) &&
+        (_phaseCal[i].finalVcsel == final_vcsel))
+      return &_phaseCal[i];
+  }
+
+  if (!add)
+    return NULL;
+
+  entry = &_phaseCal[_phaseCalNext];
+  _phaseCalNext = (_phaseCalNext + 1) % VL53L0X_PHASECAL_CACHE_SIZE;
+  entry->preVcsel = pre_vcsel;
+  entry->finalVcsel = final_vcsel;
+
+  return entry;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Let the timing budget follow the target. After each single range
+   read with readRange() or readRangeResult(), the budget is doubled when
+   the range failed or its sigma estimate is over max_sigma, and cut by a
+   quarter after VL53L0X_ADAPTIVE_HOLD ranges in a row with under half of
+   max_sigma and more signal than ambient light. In between it stays as it
+   is. Changing it is a single register write. Continuous ranging is left
+   alone
+    @param  min_budget_us Shortest budget, 20000 us or more. 0 to turn the
+   controller off
+    @param  max_budget_us Longest budget
+    @param  max_sigma Sigma estimate to stay under, 16.16 mm
+    @returns True if the arguments are valid
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::setAdaptiveBudget(uint32_t min_budget_us,
+                                            uint32_t max_budget_us,
+                                            FixPoint1616_t max_sigma) {
+  if ((min_budget_us != 0) &&
+      ((min_budget_us < 20000) || (max_budget_us < min_budget_us)))
+    return false;
+
+  _budgetMin = min_budget_us;
+  _budgetMax = max_budget_us;
+  _budgetSigma = max_sigma;
+  _budgetGood = 0;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  The setAdaptiveBudget() controller, run on every range read
+    @param  measure The range just read
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::adaptBudget(
+    const VL53L0X_RangingMeasurementData_t *measure) {
+  VL53L0X_DeviceModes device_mode;
+  FixPoint1616_t sigma = PALDevDataGet(pMyDevice, SigmaEstimate);
+  uint32_t budget;
+  uint32_t next;
+
+  VL53L0X_GETPARAMETERFIELD(pMyDevice, DeviceMode, device_mode);
+  if ((_budgetMin == 0) || (device_mode != VL53L0X_DEVICEMODE_SINGLE_RANGING))
+    return;
+
+  VL53L0X_GETPARAMETERFIELD(pMyDevice, MeasurementTimingBudgetMicroSeconds,
+                            budget);
+
+  if ((measure->RangeStatus != 0) || (sigma > _budgetSigma)) {
+    // not good enough, integrate longer straight away
+    _budgetGood = 0;
+    next = budget * 2;
+  } else if ((sigma < _budgetSigma / 2) &&
+             (measure->SignalRateRtnMegaCps >
+              measure->AmbientRateRtnMegaCps)) {
+    // comfortably good, shorten once it has been for a while
+    if (++_budgetGood < VL53L0X_ADAPTIVE_HOLD)
+      return;
+    _budgetGood = 0;
+    next = budget - budget / 4;
+  } else {
+    _budgetGood = 0;
+    return;
+  }
+
+  if (next < _budgetMin)
+    next = _budgetMin;
+  if (next > _budgetMax)
+    next = _budgetMax;
+  if (next == budget)
+    return;
+
+  // the reads setMeasurementTimingBudgetMicroSeconds() would do, done once
+  if (!_budgetPlanned) {
+    Status = VL53L0X_get_budget_plan(pMyDevice, &_budgetPlan);
+    _budgetPlanned = (Status == VL53L0X_ERROR_NONE);
+  }
+
+  if (_budgetPlanned)
+    Status = VL53L0X_set_budget_from_plan(pMyDevice, &_budgetPlan, next);
+}
+
 /**************************************************************************/
 /*!
     @brief  get a ranging measurement from the device
@@ -686,162 +1412,684 @@ void Adafruit_VL53L0X::printRangeStatus(
 
 /**************************************************************************/
 /*!
-    @brief  Single shot ranging. Be sure to check the return of readRangeStatus
-    to before using the return value!
-    @return Distance in millimeters if valid
+    @brief  Single shot ranging. Be sure to check the return of readRangeStatus
+    to before using the return value!
+    @return Distance in millimeters if valid
+*/
+/**************************************************************************/
+
+uint16_t Adafruit_VL53L0X::readRange(void) {
+  VL53L0X_RangingMeasurementData_t measure; // keep our own private copy
+
+  Status = getSingleRangingMeasurement(&measure, false);
+  _rangeStatus = measure.RangeStatus;
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    adaptBudget(&measure);
+    return measure.RangeMilliMeter;
+  }
+  // Other status return something totally out of bounds...
+  return 0xffff;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Single shot ranging that keeps the mode set up between calls.
+    The first call, and the first after anything that changed the device
+    mode, prepares the sensor. The following ones only start the range, wait
+    for it, read the result and clear the interrupt. Check readRangeStatus()
+    as with readRange()
+    @return Distance in millimeters if valid
+*/
+/**************************************************************************/
+
+uint16_t Adafruit_VL53L0X::readRangeFast(void) {
+  VL53L0X_RangingMeasurementData_t measure;
+
+  Status = VL53L0X_PerformPreparedSingleRanging(pMyDevice, &measure);
+  _rangeStatus = measure.RangeStatus;
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    adaptBudget(&measure);
+    return measure.RangeMilliMeter;
+  }
+  return 0xffff;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Request ranging success/error message (retrieve after ranging)
+    @returns One of possible VL6180X_ERROR_* values
+*/
+/**************************************************************************/
+
+uint8_t Adafruit_VL53L0X::readRangeStatus(void) { return _rangeStatus; }
+
+/**************************************************************************/
+/*!
+    @brief  Start a range operation
+    @return true if range operation successfully started.
+*/
+/**************************************************************************/
+
+boolean Adafruit_VL53L0X::startRange(void) {
+
+  /* This function will do a complete single ranging
+   * Here we fix the mode! */
+  // first lets set the device in SINGLE_Ranging mode
+  Status = VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    // Lets start up the measurement
+    Status = VL53L0X_StartMeasurement(pMyDevice);
+  }
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Checks to see if a range operation has completed
+    @return true if range operation completed or an error has happened
+*/
+/**************************************************************************/
+
+boolean Adafruit_VL53L0X::isRangeComplete(void) {
+  uint8_t NewDataReady = 0;
+  Status = VL53L0X_GetMeasurementDataReady(pMyDevice, &NewDataReady);
+  return ((Status != VL53L0X_ERROR_NONE) || (NewDataReady == 1));
+}
+
+/**************************************************************************/
+/*!
+    @brief  Wait until Range operation has completed.
+    @return true if range operation completed, false if error.
+*/
+/**************************************************************************/
+
+boolean Adafruit_VL53L0X::waitRangeComplete(void) {
+  Status = VL53L0X_measurement_poll_for_completion(pMyDevice);
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Return the range in mm for the last operation.
+    @return Range in mm.
+*/
+/**************************************************************************/
+
+uint16_t Adafruit_VL53L0X::readRangeResult(void) {
+  VL53L0X_RangingMeasurementData_t measure; // keep our own private copy
+
+  Status = VL53L0X_GetRangingMeasurementData(pMyDevice, &measure);
+  _rangeStatus = measure.RangeStatus;
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_ClearInterruptMask(pMyDevice, 0);
+  if (Status == VL53L0X_ERROR_NONE)
+    adaptBudget(&measure);
+
+  if ((Status == VL53L0X_ERROR_NONE) && (_rangeStatus != 4))
+    return measure.RangeMilliMeter;
+
+  return 0xffff; // some out of range value
+}
+
+/**************************************************************************/
+/*!
+    @brief  Same as readRangeResult(), and in single ranging starts the next
+    range in the same go, as startRange() would. Continuous ranging goes on
+    by itself
+    @param check_clear Read the interrupt status back after clearing it and
+    only start the next range once it is clear. Without, the result read,
+    the clear and the start are one chain of transfers
+    @return Range in mm.
+*/
+/**************************************************************************/
+
+uint16_t Adafruit_VL53L0X::readRangeResultAndRearm(boolean check_clear) {
+  VL53L0X_RangingMeasurementData_t measure;
+
+  Status =
+      VL53L0X_GetMeasurementDataAndRearm(pMyDevice, &measure, check_clear);
+  _rangeStatus = measure.RangeStatus;
+  if (Status == VL53L0X_ERROR_NONE)
+    adaptBudget(&measure);
+
+  if ((Status == VL53L0X_ERROR_NONE) && (_rangeStatus != 4))
+    return measure.RangeMilliMeter;
+
+  return 0xffff; // some out of range value
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a continuous range operation
+    @param period_ms inter measurement period in milliseconds
+    @return True if successful, false otherwise
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::startRangeContinuous(uint16_t period_ms) {
+  /* This function will do a complete single ranging
+   * Here we fix the mode! */
+  // first lets set the device in SINGLE_Ranging mode
+  Status = VL53L0X_SetDeviceMode(pMyDevice,
+                                 VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status =
+        VL53L0X_SetInterMeasurementPeriodMilliSeconds(pMyDevice, period_ms);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    // Lets start up the measurement
+    Status = VL53L0X_StartMeasurement(pMyDevice);
+  }
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stop a continuous ranging operation. Waits for the range in
+   flight to finish, see requestStopRangeContinuous() to carry on meanwhile
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::stopRangeContinuous(void) {
+  if (!requestStopRangeContinuous())
+    return;
+
+  // lets wait until that completes.
+  while (!serviceStop())
+    VL53L0X_PollingDelay(pMyDevice);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Ask continuous ranging to stop and return straight away. The
+   sensor finishes the range in flight first, up to a timing budget. Call
+   serviceStop() from loop(), or when GPIO1 signals that last range, until
+   it returns true. The callback, if any, is then called with the outcome
+    @param  callback Called once the stop has completed or failed
+    @param  context Passed back to the callback
+    @returns True if the stop was requested. False if that failed, the
+   callback is not called then
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::requestStopRangeContinuous(stop_callback_t callback,
+                                                     void *context) {
+  uint32_t budget_ms = (PALDevDataGet(pMyDevice, CurrentParameters)
+                            .MeasurementTimingBudgetMicroSeconds +
+                        999) /
+                       1000;
+
+  Status = VL53L0X_StopMeasurement(pMyDevice);
+  if (Status != VL53L0X_ERROR_NONE)
+    return false;
+
+  _stopCallback = callback;
+  _stopContext = context;
+  _stopStart = millis();
+  // the range in flight ends within a budget, allow for a late clock
+  _stopTimeout = 2 * budget_ms + 10;
+  _stopPending = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Complete a stop requested with requestStopRangeContinuous() if
+   the sensor has finished: clear the interrupt and call the callback. A
+   page switched register read when it has not
+    @returns True when no stop is pending anymore, whether it completed,
+   failed or timed out. Status tells which
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::serviceStop(void) {
+  uint32_t StopCompleted = 0;
+
+  if (!_stopPending)
+    return true;
+
+  Status = VL53L0X_GetStopCompletedStatus(pMyDevice, &StopCompleted);
+  if ((Status == VL53L0X_ERROR_NONE) && (StopCompleted != 0x00)) {
+    if ((millis() - _stopStart) < _stopTimeout)
+      return false;
+    Status = VL53L0X_ERROR_TIME_OUT;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status = VL53L0X_ClearInterruptMask(
+        pMyDevice, VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY);
+  }
+
+  _stopPending = false;
+  if (_stopCallback != NULL)
+    _stopCallback(Status, _stopContext);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Put the sensor in software standby, where it keeps its
+   registers and draws a few uA. Must not be ranging
+    @returns True if success
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::standby(void) {
+  // remember what the registers held, wake() checks them
+  Status = VL53L0X_get_device_signature(pMyDevice, &_standbySignature);
+  _standbySignature.StopVariable = PALDevDataGet(pMyDevice, StopVariable);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_SetPowerMode(pMyDevice, VL53L0X_POWERMODE_STANDBY_LEVEL1);
+
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Bring the sensor back from standby(). The PAL does a complete
+   StaticInit() for this, which is only needed if the sensor lost its
+   registers. A few of them are checked and the StaticInit() is skipped if
+   they are as they were
+    @returns True if the sensor is ready to range
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::wake(void) {
+  VL53L0X_DeviceSignature_t signature;
 
-uint16_t Adafruit_VL53L0X::readRange(void) {
-  VL53L0X_RangingMeasurementData_t measure; // keep our own private copy
+  Status = VL53L0X_get_device_signature(pMyDevice, &signature);
+  if (signature.StopVariable == 0x00) {
+    // zeroed by a stop sequence, same as in resume()
+    signature.StopVariable = _standbySignature.StopVariable;
+  }
 
-  Status = getSingleRangingMeasurement(&measure, false);
-  _rangeStatus = measure.RangeStatus;
+  if ((Status == VL53L0X_ERROR_NONE) &&
+      !memcmp(&signature, &_standbySignature, sizeof(signature))) {
+    // get_device_signature() leaves register 0x80 as the PAL wake does
+    PALDevDataSet(pMyDevice, PowerMode, VL53L0X_POWERMODE_IDLE_LEVEL1);
+    PALDevDataSet(pMyDevice, PalState, VL53L0X_STATE_IDLE);
+    return true;
+  }
 
-  if (Status == VL53L0X_ERROR_NONE)
-    return measure.RangeMilliMeter;
-  // Other status return something totally out of bounds...
-  return 0xffff;
+  // lost it, e.g. a brown out, do it the long way
+  Status = VL53L0X_SetPowerMode(pMyDevice, VL53L0X_POWERMODE_IDLE_LEVEL1);
+
+  return (Status == VL53L0X_ERROR_NONE);
 }
 
 /**************************************************************************/
 /*!
-    @brief  Request ranging success/error message (retrieve after ranging)
-    @returns One of possible VL6180X_ERROR_* values
+    @brief  Range with sub-millimeter resolution. Turns on the fractional
+   (quarter millimeter) range output, takes a burst of back to back ranges
+   at the current timing budget and averages the valid ones weighted by
+   their return signal rate. A burst of short ranges gets a smaller
+   uncertainty per millisecond than one long range. Use it with a short
+   budget, e.g. after configSensor(VL53L0X_SENSE_HIGH_SPEED)
+    @param  samples Number of ranges in the burst, at least 1
+    @param  range_mm The averaged range
+    @param  uncertainty_mm Optional, the 1 sigma uncertainty of range_mm: the
+   larger of the PAL sigma estimates combined and the scatter of the samples
+    @returns True if at least one range of the burst was valid. False with
+   Status VL53L0X_ERROR_INVALID_PARAMS for an empty burst
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::readRangePrecise(uint8_t samples, float *range_mm,
+                                           float *uncertainty_mm) {
+  VL53L0X_RangingMeasurementData_t measure;
+  float range, weight, sigma;
+  float sum_w = 0, sum_w2 = 0, sum_wr = 0, sum_wr2 = 0, sum_w2s2 = 0;
+  float mean, scatter, estimate;
+  VL53L0X_Error burst_status;
+  uint8_t valid = 0;
 
-uint8_t Adafruit_VL53L0X::readRangeStatus(void) { return _rangeStatus; }
+  _rangeStatus = 0xff;
+
+  // an empty burst would start and stop the sensor for nothing
+  if ((samples == 0) || (range_mm == NULL)) {
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+    return false;
+  }
+
+  if (!PALDevDataGet(pMyDevice, RangeFractionalEnable)) {
+    Status = VL53L0X_SetRangeFractionEnable(pMyDevice, 1);
+    if (Status != VL53L0X_ERROR_NONE)
+      return false;
+  }
+
+  // back to back, so there is no host overhead between the ranges
+  Status =
+      VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_CONTINUOUS_RANGING);
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_StartMeasurement(pMyDevice);
+
+  for (uint8_t i = 0; (i < samples) && (Status == VL53L0X_ERROR_NONE); i++) {
+    Status = VL53L0X_measurement_poll_for_completion(pMyDevice);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_GetRangingMeasurementData(pMyDevice, &measure);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_ClearInterruptMask(pMyDevice, 0);
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
+
+    _rangeStatus = measure.RangeStatus;
+    if (measure.RangeStatus != 0)
+      continue;
+
+    range = measure.RangeMilliMeter + measure.RangeFractionalPart / 256.0;
+    weight = measure.SignalRateRtnMegaCps / 65536.0;
+    sigma = PALDevDataGet(pMyDevice, SigmaEstimate) / 65536.0;
+
+    sum_w += weight;
+    sum_w2 += weight * weight;
+    sum_wr += weight * range;
+    sum_wr2 += weight * range * range;
+    sum_w2s2 += weight * weight * sigma * sigma;
+    valid++;
+  }
+
+  // stop in any case, but report the first error
+  burst_status = Status;
+  stopRangeContinuous();
+  if (burst_status != VL53L0X_ERROR_NONE)
+    Status = burst_status;
+  if (Status == VL53L0X_ERROR_NONE)
+    Status =
+        VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+
+  if ((Status != VL53L0X_ERROR_NONE) || (valid == 0) || (sum_w <= 0))
+    return false;
+  _rangeStatus = 0;
+
+  mean = sum_wr / sum_w;
+  *range_mm = mean;
+
+  if (uncertainty_mm != NULL) {
+    // what the PAL expects of the average
+    estimate = sqrt(sum_w2s2) / sum_w;
+    // what the samples show, weighted variance over the effective count
+    scatter = sum_wr2 / sum_w - mean * mean;
+    scatter = (scatter > 0) ? sqrt(scatter * sum_w2) / sum_w : 0;
+    *uncertainty_mm = (scatter > estimate) ? scatter : estimate;
+  }
+
+  return true;
+}
 
 /**************************************************************************/
 /*!
-    @brief  Start a range operation
-    @return true if range operation successfully started.
+    @brief  Measure and apply the range offset against a target at a known
+   distance, white and 100 mm away is what ST recommends. Ranges are taken
+   back to back until the offset is known to within tolerance_mm, at least
+   VL53L0X_CAL_MIN_SAMPLES valid ones and VL53L0X_CAL_MAX_SAMPLES at most
+    @param  distance_mm Distance to the target
+    @param  tolerance_mm Half width of the 95% confidence interval to stop at,
+   0 takes VL53L0X_CAL_MAX_SAMPLES ranges
+    @param  offset_um Optional, the offset applied. Save it to restore it
+   with VL53L0X_SetOffsetCalibrationDataMicroMeter() after the next begin()
+    @param  samples Optional, the number of ranges it took
+    @returns True if success
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::calibrateOffset(uint16_t distance_mm,
+                                          float tolerance_mm,
+                                          int32_t *offset_um,
+                                          uint16_t *samples) {
+  VL53L0X_CalibrationConvergence_t convergence;
+  int32_t offset;
 
-boolean Adafruit_VL53L0X::startRange(void) {
+  convergence.MinSamples = VL53L0X_CAL_MIN_SAMPLES;
+  convergence.MaxSamples = VL53L0X_CAL_MAX_SAMPLES;
+  convergence.Tolerance = (FixPoint1616_t)(tolerance_mm * 65536);
 
-  /* This function will do a complete single ranging
-   * Here we fix the mode! */
-  // first lets set the device in SINGLE_Ranging mode
-  Status = VL53L0X_SetDeviceMode(pMyDevice, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+  Status = VL53L0X_PerformOffsetCalibrationConverged(
+      pMyDevice, (FixPoint1616_t)distance_mm << 16, &convergence, &offset,
+      samples);
+
+  if ((Status == VL53L0X_ERROR_NONE) && (offset_um != NULL))
+    *offset_um = offset;
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    // Lets start up the measurement
-    Status = VL53L0X_StartMeasurement(pMyDevice);
-  }
   return (Status == VL53L0X_ERROR_NONE);
 }
 
 /**************************************************************************/
 /*!
-    @brief  Checks to see if a range operation has completed
-    @return true if range operation completed or an error has happened
+    @brief  Measure and apply the cover glass crosstalk compensation against
+   a grey target at a known distance, where the sensor starts to under range.
+   Ranges are taken back to back until the compensation rate is known to
+   within tolerance_mcps, at least VL53L0X_CAL_MIN_SAMPLES valid ones and
+   VL53L0X_CAL_MAX_SAMPLES at most
+    @param  distance_mm Distance to the target
+    @param  tolerance_mcps Half width of the 95% confidence interval to stop
+   at, 0 takes VL53L0X_CAL_MAX_SAMPLES ranges
+    @param  rate_mcps Optional, the compensation rate applied, per SPAD
+    @param  samples Optional, the number of ranges it took
+    @returns True if success
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::calibrateXTalk(uint16_t distance_mm,
+                                         float tolerance_mcps,
+                                         float *rate_mcps,
+                                         uint16_t *samples) {
+  VL53L0X_CalibrationConvergence_t convergence;
+  FixPoint1616_t rate;
 
-boolean Adafruit_VL53L0X::isRangeComplete(void) {
-  uint8_t NewDataReady = 0;
-  Status = VL53L0X_GetMeasurementDataReady(pMyDevice, &NewDataReady);
-  return ((Status != VL53L0X_ERROR_NONE) || (NewDataReady == 1));
+  convergence.MinSamples = VL53L0X_CAL_MIN_SAMPLES;
+  convergence.MaxSamples = VL53L0X_CAL_MAX_SAMPLES;
+  convergence.Tolerance = (FixPoint1616_t)(tolerance_mcps * 65536);
+
+  Status = VL53L0X_PerformXTalkCalibrationConverged(
+      pMyDevice, (FixPoint1616_t)distance_mm << 16, &convergence, &rate,
+      samples);
+
+  if ((Status == VL53L0X_ERROR_NONE) && (rate_mcps != NULL))
+    *rate_mcps = rate / 65536.0;
+
+  return (Status == VL53L0X_ERROR_NONE);
 }
 
 /**************************************************************************/
 /*!
-    @brief  Wait until Range operation has completed.
-    @return true if range operation completed, false if error.
+    @brief  Range continuously but only report when the range leaves or
+   comes back into [low_mm, high_mm]. The sensor compares each range with
+   its thresholds and raises GPIO1 only on a crossing, the host can sleep in
+   between. Once outside, the threshold is moved hysteresis_mm into the
+   window, so a target sitting on the edge does not flood the host. Call
+   serviceRangeEvents() when GPIO1 goes low, or just poll it
+    @param  low_mm Lower edge of the window, 2 mm resolution
+    @param  high_mm Upper edge of the window, 2 mm resolution
+    @param  hysteresis_mm How far back into the window a range has to come
+   to count as inside again
+    @param  callback Called with the range and the new zone on each crossing
+    @param  period_ms Time between ranges
+    @returns True if ranging was started
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::startRangeEvents(uint16_t low_mm, uint16_t high_mm,
+                                           uint16_t hysteresis_mm,
+                                           range_event_callback_t callback,
+                                           uint16_t period_ms) {
+  if ((callback == NULL) || (high_mm <= low_mm) ||
+      (2 * hysteresis_mm > high_mm - low_mm))
+    return false;
 
-boolean Adafruit_VL53L0X::waitRangeComplete(void) {
-  Status = VL53L0X_measurement_poll_for_completion(pMyDevice);
+  _eventLow = low_mm;
+  _eventHigh = high_mm;
+  _eventHysteresis = hysteresis_mm;
+  _eventCallback = callback;
+  // if it is not, the first range says so
+  _eventZone = VL53L0X_ZONE_INSIDE;
 
-  return (Status == VL53L0X_ERROR_NONE);
+  Status =
+      VL53L0X_SetInterMeasurementPeriodMilliSeconds(pMyDevice, period_ms);
+
+  if ((Status != VL53L0X_ERROR_NONE) || !armRangeEvent()) {
+    _eventCallback = NULL;
+    return false;
+  }
+
+  return true;
 }
 
 /**************************************************************************/
 /*!
-    @brief  Return the range in mm for the last operation.
-    @return Range in mm.
+    @brief  Handle a threshold crossing signalled by the sensor: read the
+   range, call the callback if the zone changed and arm the thresholds for
+   the way back. Never waits for the sensor: arming stops ranging without
+   waiting, the following calls finish the stop and restart it. GPIO1 stays
+   low until then. Cheap to call when nothing happened, one register read
+    @returns True if the callback was called
 */
 /**************************************************************************/
+boolean Adafruit_VL53L0X::serviceRangeEvents(void) {
+  VL53L0X_RangingMeasurementData_t measure;
+  VL53L0X_Zone_t zone;
+  uint32_t interrupt_status;
 
-uint16_t Adafruit_VL53L0X::readRangeResult(void) {
-  VL53L0X_RangingMeasurementData_t measure; // keep our own private copy
+  if (_eventCallback == NULL)
+    return false;
+
+  if (_stopPending) {
+    // re-arming, ranging restarts once the last range is over
+    serviceStop();
+    return false;
+  }
+
+  Status = VL53L0X_GetInterruptMaskStatus(pMyDevice, &interrupt_status);
+  if ((Status != VL53L0X_ERROR_NONE) || (interrupt_status == 0))
+    return false;
 
   Status = VL53L0X_GetRangingMeasurementData(pMyDevice, &measure);
+  if (Status != VL53L0X_ERROR_NONE)
+    return false;
   _rangeStatus = measure.RangeStatus;
-  if (Status == VL53L0X_ERROR_NONE)
+
+  // no target reads as a very long range, the device compares it that way
+  if (measure.RangeMilliMeter < _eventLow)
+    zone = VL53L0X_ZONE_BELOW;
+  else if (measure.RangeMilliMeter > _eventHigh)
+    zone = VL53L0X_ZONE_ABOVE;
+  else
+    zone = VL53L0X_ZONE_INSIDE;
+
+  if (zone == _eventZone) {
+    // crossed back before we got to it, nothing to report
     Status = VL53L0X_ClearInterruptMask(pMyDevice, 0);
+    return false;
+  }
 
-  if ((Status == VL53L0X_ERROR_NONE) && (_rangeStatus != 4))
-    return measure.RangeMilliMeter;
+  _eventZone = zone;
+  if (!armRangeEvent())
+    return false;
 
-  return 0xffff; // some out of range value
+  _eventCallback(measure.RangeMilliMeter, zone);
+  return true;
 }
 
 /**************************************************************************/
 /*!
-    @brief  Start a continuous range operation
-    @param period_ms inter measurement period in milliseconds
-    @return True if successful, false otherwise
+    @brief  Stop the ranging started by startRangeEvents() and put GPIO1
+   back to signalling every new range. Waits for the range in flight
 */
 /**************************************************************************/
-boolean Adafruit_VL53L0X::startRangeContinuous(uint16_t period_ms) {
-  /* This function will do a complete single ranging
-   * Here we fix the mode! */
-  // first lets set the device in SINGLE_Ranging mode
-  Status = VL53L0X_SetDeviceMode(pMyDevice,
-                                 VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING);
-
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status =
-        VL53L0X_SetInterMeasurementPeriodMilliSeconds(pMyDevice, period_ms);
-  }
+void Adafruit_VL53L0X::stopRangeEvents(void) {
+  if (_eventCallback == NULL)
+    return;
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    // Lets start up the measurement
-    Status = VL53L0X_StartMeasurement(pMyDevice);
+  _eventCallback = NULL;
+  if (_stopPending) {
+    // caught re-arming, finish that stop and do not restart
+    while (!serviceStop())
+      VL53L0X_PollingDelay(pMyDevice);
+  } else {
+    stopRangeContinuous();
   }
-  return (Status == VL53L0X_ERROR_NONE);
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_SetGpioConfig(
+        pMyDevice, 0, VL53L0X_DEVICEMODE_SINGLE_RANGING,
+        VL53L0X_GPIOFUNCTIONALITY_NEW_MEASURE_READY,
+        VL53L0X_INTERRUPTPOLARITY_LOW);
 }
 
 /**************************************************************************/
 /*!
-    @brief  Stop a continuous ranging operation
+    @brief  (Re)start timed ranging with the thresholds that catch the next
+   crossing out of _eventZone. The device only loads the thresholds over
+   255 mm at start, so it is stopped and started again. The stop is only
+   requested here, rangeEventStopped() restarts ranging once it completed
+    @returns True if ranging was started, or its stop requested
 */
 /**************************************************************************/
-void Adafruit_VL53L0X::stopRangeContinuous(void) {
+boolean Adafruit_VL53L0X::armRangeEvent(void) {
+  if (PALDevDataGet(pMyDevice, PalState) == VL53L0X_STATE_RUNNING)
+    return requestStopRangeContinuous(rangeEventStopped, this);
 
-  Status = VL53L0X_StopMeasurement(pMyDevice);
+  return startRangeEvent();
+}
 
-  // lets wait until that completes.
-  uint32_t StopCompleted = 0;
-  uint32_t LoopNb;
+/**************************************************************************/
+/*!
+    @brief  Called when the stop requested by armRangeEvent() is over,
+   starts ranging again unless stopRangeEvents() came in between
+    @param  status Outcome of the stop
+    @param  context The sensor object
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::rangeEventStopped(VL53L0X_Error status,
+                                         void *context) {
+  Adafruit_VL53L0X *sensor = (Adafruit_VL53L0X *)context;
 
-  // Wait until it finished
-  // use timeout to avoid deadlock
-  if (Status == VL53L0X_ERROR_NONE) {
-    LoopNb = 0;
-    do {
-      Status = VL53L0X_GetStopCompletedStatus(pMyDevice, &StopCompleted);
-      if ((StopCompleted == 0x00) || Status != VL53L0X_ERROR_NONE) {
-        break;
-      }
-      LoopNb = LoopNb + 1;
-      VL53L0X_PollingDelay(pMyDevice);
-    } while (LoopNb < VL53L0X_DEFAULT_MAX_LOOP);
+  if ((status == VL53L0X_ERROR_NONE) && (sensor->_eventCallback != NULL))
+    sensor->startRangeEvent();
+}
 
-    if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP) {
-      Status = VL53L0X_ERROR_TIME_OUT;
-    }
-  }
+/**************************************************************************/
+/*!
+    @brief  Start timed ranging with the thresholds that catch the next
+   crossing out of _eventZone. The sensor must not be ranging
+    @returns True if ranging was started
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::startRangeEvent(void) {
+  VL53L0X_GpioFunctionality functionality;
+  FixPoint1616_t threshold_low;
+  FixPoint1616_t threshold_high;
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_ClearInterruptMask(
-        pMyDevice, VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY);
+  switch (_eventZone) {
+  case VL53L0X_ZONE_BELOW:
+    functionality = VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_HIGH;
+    threshold_low = (FixPoint1616_t)(_eventLow + _eventHysteresis) << 16;
+    threshold_high = threshold_low;
+    break;
+  case VL53L0X_ZONE_ABOVE:
+    functionality = VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_LOW;
+    threshold_low = (FixPoint1616_t)(_eventHigh - _eventHysteresis) << 16;
+    threshold_high = threshold_low;
+    break;
+  default:
+    functionality = VL53L0X_GPIOFUNCTIONALITY_THRESHOLD_CROSSED_OUT;
+    threshold_low = (FixPoint1616_t)_eventLow << 16;
+    threshold_high = (FixPoint1616_t)_eventHigh << 16;
+    break;
   }
+
+  Status = VL53L0X_SetGpioConfig(
+      pMyDevice, 0, VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING, functionality,
+      VL53L0X_INTERRUPTPOLARITY_LOW);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_SetInterruptThresholds(
+        pMyDevice, VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING, threshold_low,
+        threshold_high);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_SetDeviceMode(pMyDevice,
+                                   VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_StartMeasurement(pMyDevice);
+
+  return (Status == VL53L0X_ERROR_NONE);
 }
 
 /**************************************************************************/
@@ -872,6 +2120,73 @@ uint32_t Adafruit_VL53L0X::getMeasurementTimingBudgetMicroSeconds() {
   return (budget_us);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Return signal rate of the reference SPADs in the last range. It
+   does not depend on the target, but follows the VCSEL output, which falls
+   as the sensor warms up
+    @returns Rate in MCPS, 16.16
+*/
+/**************************************************************************/
+FixPoint1616_t Adafruit_VL53L0X::getReferenceSignalRate(void) {
+  return PALDevDataGet(pMyDevice, LastSignalRefMcps);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Shortest timing budget the enabled sequence steps allow
+    @returns The budget in microseconds, 0 if it could not be read
+*/
+/**************************************************************************/
+uint32_t Adafruit_VL53L0X::getMinimumTimingBudgetMicroSeconds(void) {
+  uint32_t min_budget_us = 20000; // PAL lower limit
+
+  if (!_budgetPlanned) {
+    Status = VL53L0X_get_budget_plan(pMyDevice, &_budgetPlan);
+    _budgetPlanned = (Status == VL53L0X_ERROR_NONE);
+  }
+  if (!_budgetPlanned)
+    return 0;
+
+  // the final range needs its own 550 us overhead and a bit of time
+  if (_budgetPlan.OverheadMicroSeconds + 551 > min_budget_us)
+    min_budget_us = _budgetPlan.OverheadMicroSeconds + 551;
+
+  return min_budget_us;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Turn one of the steps of a range on or off. The timing budget is
+   kept, the time saved goes to the final range
+    @param  SequenceStepId VL53L0X_SEQUENCESTEP_TCC, _MSRC, _DSS, _PRE_RANGE
+   or _FINAL_RANGE
+    @param  enable True to run the step
+    @returns True if success
+*/
+/**************************************************************************/
+boolean
+Adafruit_VL53L0X::setSequenceStepEnable(VL53L0X_SequenceStepId SequenceStepId,
+                                        boolean enable) {
+  _budgetPlanned = false;
+  Status =
+      VL53L0X_SetSequenceStepEnable(pMyDevice, SequenceStepId, enable ? 1 : 0);
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read which steps of a range are on
+    @param  steps Where to store the result
+    @returns True if success
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X::getSequenceStepEnables(
+    VL53L0X_SchedulerSequenceSteps_t *steps) {
+  Status = VL53L0X_GetSequenceStepEnables(pMyDevice, steps);
+  return (Status == VL53L0X_ERROR_NONE);
+}
+
 /**************************************************************************/
 /*!
     @brief Sets the VCSEL pulse period.
@@ -884,6 +2199,7 @@ uint32_t Adafruit_VL53L0X::getMeasurementTimingBudgetMicroSeconds() {
 boolean
 Adafruit_VL53L0X::setVcselPulsePeriod(VL53L0X_VcselPeriod VcselPeriodType,
                                       uint8_t VCSELPulsePeriod) {
+  _budgetPlanned = false;
   Status =
       VL53L0X_SetVcselPulsePeriod(pMyDevice, VcselPeriodType, VCSELPulsePeriod);
   return (Status == VL53L0X_ERROR_NONE);
@@ -972,3 +2288,211 @@ FixPoint1616_t Adafruit_VL53L0X::getLimitCheckValue(uint16_t LimitCheckId) {
       VL53L0X_GetLimitCheckValue(pMyDevice, LimitCheckId, &LimitCheckValue);
   return (LimitCheckValue);
 }
+
+/**************************************************************************/
+/*!
+    @brief  Print the call count and min/avg/max time, in microseconds, of
+   every PAL function called since the last reset. Times include the
+   functions called from it. Needs VL53L0X_LATENCY_ENABLE, see
+   vl53l0x_platform_log.h
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::printLatencyProfile(void) {
+#if !defined(VL53L0X_LOG_ENABLE) && defined(VL53L0X_LATENCY_ENABLE)
+  const VL53L0X_LatencyEntry_t *pEntry;
+
+  Serial.println(F("calls\tmin\tavg\tmax\ttotal\tfunction"));
+  for (uint8_t i = 0; i < VL53L0X_latency_get_count(); i++) {
+    pEntry = VL53L0X_latency_get_entry(i);
+    Serial.print(pEntry->Calls);
+    Serial.print('\t');
+    Serial.print(pEntry->MinMicroSeconds);
+    Serial.print('\t');
+    Serial.print(pEntry->TotalMicroSeconds / pEntry->Calls);
+    Serial.print('\t');
+    Serial.print(pEntry->MaxMicroSeconds);
+    Serial.print('\t');
+    Serial.print(pEntry->TotalMicroSeconds);
+    Serial.print('\t');
+    Serial.println(pEntry->Function);
+  }
+  if (VL53L0X_latency_get_dropped()) {
+    Serial.print(F("dropped "));
+    Serial.println(VL53L0X_latency_get_dropped());
+  }
+#else
+  Serial.println(F("define VL53L0X_LATENCY_ENABLE to profile"));
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Clear the PAL latency profile, e.g. after begin() to look at
+   ranging alone
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::resetLatencyProfile(void) {
+#if !defined(VL53L0X_LOG_ENABLE) && defined(VL53L0X_LATENCY_ENABLE)
+  VL53L0X_latency_reset();
+#endif
+}
+
+// fixed width, so a trace line can be split at known offsets
+static void printHex(uint32_t value, uint8_t digits) {
+  while (digits--)
+    Serial.print((value >> (4 * digits)) & 0xf, HEX);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print the register transactions kept in the I2C trace ring,
+   oldest first, for extras/vl53l0x_trace_decode.py to decode. Each
+   transaction is one line: "T" then micros, duration, address, op, register,
+   length, status and data bytes in fixed width hex. Needs VL53L0X_I2C_TRACE,
+   see vl53l0x_i2c_platform.h
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::printI2CTrace(void) {
+#ifdef VL53L0X_I2C_TRACE
+  const VL53L0X_I2cTraceRecord_t *pRecord;
+  uint16_t count = VL53L0X_i2c_trace_count();
+
+  Serial.print(F("VL53L0X trace "));
+  Serial.print(count);
+  Serial.print(F(" of "));
+  Serial.println(VL53L0X_i2c_trace_total());
+  for (uint16_t i = 0; i < count; i++) {
+    pRecord = VL53L0X_i2c_trace_get(i);
+    Serial.print(F("T "));
+    printHex(pRecord->micros, 8);
+    printHex(pRecord->duration, 4);
+    printHex(pRecord->address, 2);
+    printHex(pRecord->op, 2);
+    printHex(pRecord->index, 2);
+    printHex(pRecord->length, 2);
+    printHex(pRecord->status, 2);
+    for (uint8_t j = 0; j < VL53L0X_I2C_TRACE_DATA; j++)
+      printHex(pRecord->data[j], 2);
+    Serial.println();
+  }
+  Serial.println(F("VL53L0X trace end"));
+#else
+  Serial.println(F("define VL53L0X_I2C_TRACE to trace"));
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Empty the I2C trace ring, e.g. right before the operation of
+   interest
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::resetI2CTrace(void) {
+#ifdef VL53L0X_I2C_TRACE
+  VL53L0X_i2c_trace_reset();
+#endif
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get called with the raw result registers of every range, e.g. to
+   log them for extras/replay. The callback runs in the middle of reading
+   the range, keep it short
+    @param  callback The function, or NULL to disable. printRawResult() logs
+   them over Serial
+    @param  context Passed on to the callback
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::setRawResultCallback(raw_result_callback_t callback,
+                                            void *context) {
+  pMyDevice->RawResultHook = callback;
+  pMyDevice->RawResultContext = context;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Tell how to read the level of GPIO1 on the host side, for
+   example through a port expander. While GPIO1 signals new samples, as it
+   does after begin(), isRangeComplete(), waitRangeComplete() and the
+   ranging functions check the pin instead of polling the sensor over I2C.
+   Range events and other GPIO1 functions still poll the sensor
+    @param  reader Returns the pin level, NULL to go back to polling
+    @param  context Passed back to the reader
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::setGpioLevelReader(gpio_level_reader_t reader,
+                                          void *context) {
+  pMyDevice->GpioLevelHook = reader;
+  pMyDevice->GpioLevelContext = context;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Same as setGpioLevelReader() for GPIO1 wired straight to a pin
+   of the board, read with digitalRead()
+    @param  pin The pin, -1 to go back to polling the sensor
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X::setDataReadyPin(int8_t pin) {
+  _dataReadyPin = pin;
+  if (pin < 0) {
+    setGpioLevelReader(NULL);
+    return;
+  }
+  // GPIO1 is open drain on the sensor, breakouts pull it up
+  pinMode(pin, INPUT);
+  setGpioLevelReader(readDataReadyPin, this);
+}
+
+/**************************************************************************/
+/*!
+    @brief  gpio_level_reader_t for setDataReadyPin()
+    @param  context The sensor object
+    @returns 1 if the pin is high, 0 if low
+*/
+/**************************************************************************/
+uint8_t Adafruit_VL53L0X::readDataReadyPin(void *context) {
+  Adafruit_VL53L0X *sensor = (Adafruit_VL53L0X *)context;
+  return (digitalRead(sensor->_dataReadyPin) == HIGH) ? 1 : 0;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print the configuration that decoding a range depends on, as a
+   "C" line for extras/replay. Print it before logging raw results and again
+   whenever the configuration changes
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::printDecodeConfig(void) {
+  VL53L0X_DecodeConfig_t config;
+  uint8_t packed[VL53L0X_DECODE_CONFIG_PACKED_SIZE];
+
+  Status = VL53L0X_get_decode_config(pMyDevice, &config);
+  VL53L0X_pack_decode_config(&config, packed);
+
+  Serial.print(F("C "));
+  for (uint8_t i = 0; i < VL53L0X_DECODE_CONFIG_PACKED_SIZE; i++)
+    printHex(packed[i], 2);
+  Serial.println();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Print a raw result as an "R" line for extras/replay, fits
+   setRawResultCallback()
+    @param  raw The raw result
+    @param  context Unused
+ */
+/**************************************************************************/
+void Adafruit_VL53L0X::printRawResult(const VL53L0X_RawResult_t *raw,
+                                      void *context) {
+  uint8_t packed[VL53L0X_RAW_RESULT_PACKED_SIZE];
+
+  (void)context;
+  VL53L0X_pack_raw_result(raw, packed);
+
+  Serial.print(F("R "));
+  for (uint8_t i = 0; i < VL53L0X_RAW_RESULT_PACKED_SIZE; i++)
+    printHex(packed[i], 2);
+  Serial.println();
+}
@@ -28,10 +28,25 @@
 #include "WProgram.h"
 #endif
 
+#include "Adafruit_VL53L0X_Profile.h"
 #include "Wire.h"
 #include "vl53l0x_api.h"
 
 #define VL53L0X_I2C_ADDR 0x29 ///< Default sensor I2C address
+#ifndef VL53L0X_PHASECAL_CACHE_SIZE
+#define VL53L0X_PHASECAL_CACHE_SIZE 4 ///< VCSEL pairs applyProfile() keeps
+#endif
+#ifndef VL53L0X_ADAPTIVE_HOLD
+#define VL53L0X_ADAPTIVE_HOLD 4 ///< Good samples in a row before shortening
+#endif
+#ifndef VL53L0X_CAL_MIN_SAMPLES
+#define VL53L0X_CAL_MIN_SAMPLES 10 ///< Calibration ranges before stopping
+#endif
+#ifndef VL53L0X_CAL_MAX_SAMPLES
+#define VL53L0X_CAL_MAX_SAMPLES 250 ///< Calibration ranges, converged or not
+#endif
+#define VL53L0X_RESUME_MAGIC                                                   \
+  (0x564C0000UL | sizeof(VL53L0X_DevData_t)) ///< Marks a valid resume image
 
 /**************************************************************************/
 /*!
@@ -46,14 +61,98 @@ public:
     VL53L0X_SENSE_DEFAULT = 0,
     VL53L0X_SENSE_LONG_RANGE,
     VL53L0X_SENSE_HIGH_SPEED,
-    VL53L0X_SENSE_HIGH_ACCURACY
+    VL53L0X_SENSE_HIGH_ACCURACY,
+    VL53L0X_SENSE_ULTRA_FAST
   } VL53L0X_Sense_config_t;
 
+  /** Where a range lies relative to the startRangeEvents() window */
+  typedef enum {
+    VL53L0X_ZONE_BELOW = 0,
+    VL53L0X_ZONE_INSIDE,
+    VL53L0X_ZONE_ABOVE
+  } VL53L0X_Zone_t;
+
+  /**************************************************************************/
+  /*!
+      @brief  Callback invoked when the range moves to another zone
+      @param  range_mm The range that crossed the threshold
+      @param  zone The zone it is in now
+  */
+  /**************************************************************************/
+  typedef void (*range_event_callback_t)(uint16_t range_mm,
+                                         VL53L0X_Zone_t zone);
+
+  /**************************************************************************/
+  /*!
+      @brief  Callback invoked with every result block read from the sensor,
+     before it is decoded
+      @param  raw The result registers and reference signal rate
+      @param  context The pointer given to setRawResultCallback()
+  */
+  /**************************************************************************/
+  typedef void (*raw_result_callback_t)(const VL53L0X_RawResult_t *raw,
+                                        void *context);
+
+  /**************************************************************************/
+  /*!
+      @brief  Callback invoked when a stop requested with
+     requestStopRangeContinuous() has completed
+      @param  status VL53L0X_ERROR_NONE, or what went wrong while stopping
+      @param  context The pointer given to requestStopRangeContinuous()
+  */
+  /**************************************************************************/
+  typedef void (*stop_callback_t)(VL53L0X_Error status, void *context);
+
+  /**************************************************************************/
+  /*!
+      @brief  Reads the host pin wired to GPIO1 of the sensor
+      @param  context The pointer given to setGpioLevelReader()
+      @returns 1 if the pin is high, 0 if low
+  */
+  /**************************************************************************/
+  typedef uint8_t (*gpio_level_reader_t)(void *context);
+
+  /** Host side state kept by saveState() for a later resume() */
+  typedef struct {
+    uint32_t magic;                      ///< VL53L0X_RESUME_MAGIC if valid
+    VL53L0X_DeviceSignature_t signature; ///< device registers when saved
+    VL53L0X_DevData_t data;              ///< driver state when saved
+  } VL53L0X_ResumeImage_t;
+
+  /** Reference calibration results, to skip the calibration after a reset */
+  typedef struct {
+    uint32_t refSpadCount;   ///< reference SPADs enabled
+    uint8_t isApertureSpads; ///< 1 if those are aperture SPADs
+    uint8_t vhvSettings;     ///< VHV calibration result
+    uint8_t phaseCal;        ///< phase calibration result
+  } VL53L0X_RefCalibration_t;
+
   boolean begin(uint8_t i2c_addr = VL53L0X_I2C_ADDR, boolean debug = false,
                 TwoWire *i2c = &Wire,
                 VL53L0X_Sense_config_t vl_config = VL53L0X_SENSE_DEFAULT);
   boolean setAddress(uint8_t newAddr);
 
+  boolean initSensor(uint8_t i2c_addr = VL53L0X_I2C_ADDR, boolean debug = false,
+                     TwoWire *i2c = &Wire);
+  boolean startInit(uint8_t i2c_addr = VL53L0X_I2C_ADDR, boolean debug = false,
+                    TwoWire *i2c = &Wire);
+  boolean initStep(void);
+  boolean startCalibration(boolean ref_spads = true);
+  boolean calibrationStep(void);
+  void abortCalibration(void);
+  void setCalibrationScratch(VL53L0X_CalibrationState_t *scratch);
+  boolean getRefCalibration(VL53L0X_RefCalibration_t *cal);
+  boolean setRefCalibration(const VL53L0X_RefCalibration_t *cal);
+
+  void setNvmCache(VL53L0X_NvmInfo_t *info, boolean verify = true);
+  boolean setVerifyPolicy(VL53L0X_VerifyPolicy policy);
+  uint16_t getVerifyFailures(void);
+
+  boolean saveState(VL53L0X_ResumeImage_t *image);
+  boolean resume(const VL53L0X_ResumeImage_t *image,
+                 uint8_t i2c_addr = VL53L0X_I2C_ADDR, boolean debug = false,
+                 TwoWire *i2c = &Wire);
+
   // uint8_t getAddress(void); // not currently implemented
 
   /**************************************************************************/
@@ -113,6 +212,7 @@ public:
                           ///< encountered an error
   // Add similar methods as Adafruit_VL6180X class adapted to range of device
   uint16_t readRange(void);
+  uint16_t readRangeFast(void);
   // float readLux(uint8_t gain);
   uint8_t readRangeStatus(void);
 
@@ -120,9 +220,53 @@ public:
   boolean isRangeComplete(void);
   boolean waitRangeComplete(void);
   uint16_t readRangeResult(void);
+  uint16_t readRangeResultAndRearm(boolean check_clear = true);
 
   boolean startRangeContinuous(uint16_t period_ms = 50);
   void stopRangeContinuous(void);
+  boolean requestStopRangeContinuous(stop_callback_t callback = NULL,
+                                     void *context = NULL);
+  boolean serviceStop(void);
+
+  /**************************************************************************/
+  /*!
+      @brief  Whether a stop requested with requestStopRangeContinuous() is
+     still waiting for the range in flight
+      @returns True until serviceStop() sees the stop complete
+  */
+  /**************************************************************************/
+  boolean isStopping(void) { return _stopPending; }
+
+  boolean standby(void);
+  boolean wake(void);
+
+  boolean readRangePrecise(uint8_t samples, float *range_mm,
+                           float *uncertainty_mm = NULL);
+
+  boolean calibrateOffset(uint16_t distance_mm, float tolerance_mm = 1.0,
+                          int32_t *offset_um = NULL, uint16_t *samples = NULL);
+  boolean calibrateXTalk(uint16_t distance_mm, float tolerance_mcps = 0.0005,
+                         float *rate_mcps = NULL, uint16_t *samples = NULL);
+
+  boolean startRangeEvents(uint16_t low_mm, uint16_t high_mm,
+                           uint16_t hysteresis_mm,
+                           range_event_callback_t callback,
+                           uint16_t period_ms = 100);
+  boolean serviceRangeEvents(void);
+  void stopRangeEvents(void);
+
+  static void printLatencyProfile(void);
+  static void resetLatencyProfile(void);
+  static void printI2CTrace(void);
+  static void resetI2CTrace(void);
+
+  void setRawResultCallback(raw_result_callback_t callback,
+                            void *context = NULL);
+  void setGpioLevelReader(gpio_level_reader_t reader, void *context = NULL);
+  void setDataReadyPin(int8_t pin);
+  void printDecodeConfig(void);
+  static void printRawResult(const VL53L0X_RawResult_t *raw,
+                             void *context = NULL);
 
   //  void setTimeout(uint16_t timeout) { io_timeout = timeout; }
   // uint16_t getTimeout(void) { return io_timeout; }
@@ -135,12 +279,23 @@ public:
   boolean timeoutOccurred(void) { return false; }
 
   boolean configSensor(VL53L0X_Sense_config_t vl_config);
+  boolean compileProfile(VL53L0X_Sense_config_t vl_config,
+                         VL53L0X_Profile_t *profile);
+  boolean applyProfile(const VL53L0X_Profile_t *profile);
+  boolean setAdaptiveBudget(uint32_t min_budget_us, uint32_t max_budget_us,
+                            FixPoint1616_t max_sigma = 15 * 65536);
 
   // Export some wrappers to internal setting functions
   // that are used by the above helper function to allow
   // more complete control.
   boolean setMeasurementTimingBudgetMicroSeconds(uint32_t budget_us);
   uint32_t getMeasurementTimingBudgetMicroSeconds(void);
+  uint32_t getMinimumTimingBudgetMicroSeconds(void);
+  FixPoint1616_t getReferenceSignalRate(void);
+
+  boolean setSequenceStepEnable(VL53L0X_SequenceStepId SequenceStepId,
+                                boolean enable);
+  boolean getSequenceStepEnables(VL53L0X_SchedulerSequenceSteps_t *steps);
 
   boolean setVcselPulsePeriod(VL53L0X_VcselPeriod VcselPeriodType,
                               uint8_t VCSELPulsePeriod);
@@ -154,9 +309,77 @@ public:
   FixPoint1616_t getLimitCheckValue(uint16_t LimitCheckId);
 
 private:
-  VL53L0X_Dev_t MyDevice;
+  VL53L0X_Dev_t MyDevice = VL53L0X_Dev_t();
   VL53L0X_Dev_t *pMyDevice = &MyDevice;
-  VL53L0X_DeviceInfo_t DeviceInfo;
+#if VL53L0X_SLIM
+  // calibration state lives outside the object, see setCalibrationScratch()
+  VL53L0X_CalibrationState_t *_calScratch = NULL;
+  static VL53L0X_CalibrationState_t _calShared;
+  static Adafruit_VL53L0X *_calOwner;
+#else
+  VL53L0X_CalibrationState_t _calState = {};
+#endif
+  VL53L0X_CalibrationState_t *calibrationState(void);
+  boolean _calRefPending = false;
+
+  /** Where an initSensor() run by initStep() is */
+  typedef enum {
+    INIT_DONE = 0, ///< nothing left to do
+    INIT_DATA,     ///< probe, data init and address change
+    INIT_ADDRESS,  ///< letting the new address settle
+    INIT_INFO,     ///< NVM cache check and device info
+    INIT_STATIC,   ///< static init, one VL53L0X_StaticInitStep() at a time
+    INIT_CACHE     ///< filling the NVM cache
+  } init_step_t;
+  uint8_t _initStep = INIT_DONE;
+  uint8_t _initAddr = VL53L0X_I2C_ADDR;
+  boolean _initDebug = false;
+  VL53L0X_InitState_t _initState = {};
+  uint32_t _initTime = 0;
+  VL53L0X_NvmInfo_t *_nvmInfo = NULL;
+  boolean _nvmVerify = true;
+
+  /** Phase calibration of one pair of VCSEL periods */
+  typedef struct {
+    uint8_t preVcsel;   ///< pre-range VCSEL period, 0 if unused
+    uint8_t finalVcsel; ///< final range VCSEL period
+    uint8_t phaseCal;   ///< phase calibration result
+  } phasecal_entry_t;
+  phasecal_entry_t _phaseCal[VL53L0X_PHASECAL_CACHE_SIZE] = {};
+  uint8_t _phaseCalNext = 0;
+
+  phasecal_entry_t *findPhaseCal(uint8_t pre_vcsel, uint8_t final_vcsel,
+                                 boolean add);
+
+  VL53L0X_BudgetPlan_t _budgetPlan;
+  boolean _budgetPlanned = false;
+  uint32_t _budgetMin = 0;
+  uint32_t _budgetMax = 0;
+  FixPoint1616_t _budgetSigma = 0;
+  uint8_t _budgetGood = 0;
+
+  void adaptBudget(const VL53L0X_RangingMeasurementData_t *measure);
+
+  range_event_callback_t _eventCallback = NULL;
+  uint16_t _eventLow = 0;
+  uint16_t _eventHigh = 0;
+  uint16_t _eventHysteresis = 0;
+  VL53L0X_Zone_t _eventZone = VL53L0X_ZONE_INSIDE;
+
+  boolean armRangeEvent(void);
+  boolean startRangeEvent(void);
+  static void rangeEventStopped(VL53L0X_Error status, void *context);
+
+  int8_t _dataReadyPin = -1;
+  static uint8_t readDataReadyPin(void *context);
+
+  stop_callback_t _stopCallback = NULL;
+  void *_stopContext = NULL;
+  boolean _stopPending = false;
+  uint32_t _stopStart = 0;
+  uint32_t _stopTimeout = 0;
+
+  VL53L0X_DeviceSignature_t _standbySignature;
 
   uint8_t _rangeStatus;
 };
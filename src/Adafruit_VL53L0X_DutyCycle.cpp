@@ -0,0 +1,279 @@
+/*!
+ * @file Adafruit_VL53L0X_DutyCycle.cpp
+ *
+ * Low power, duty cycled ranging for the Adafruit VL53L0X library.
+ *
+ * A range costs the same in every mode, what differs is the current drawn
+ * between ranges and what it takes to get going again: nothing for timed
+ * continuous ranging, a few I2C transfers to leave software standby, a boot
+ * and init after XSHUT, with the calibration put back rather than run
+ * again. begin() works out the charge per range of each mode from the
+ * VL53L0X_CURRENT_* estimates and keeps the cheapest.
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X_DutyCycle.h"
+
+/**************************************************************************/
+/*!
+    @brief  Pick a mode and start taking a range every period. The sensor
+   must have been started with begin() and be idle
+    @param  sensor The sensor object
+    @param  period_ms Time between ranges
+    @param  current_budget_ua Average sensor current not to exceed. If no
+   mode fits at the current timing budget, the timing budget is shortened,
+   down to 20 ms
+    @param  shutdown_pin Pin wired to the XSHUT line of the sensor, -1 if
+   none. Without one the sensor is never powered down
+    @param  i2c_addr Address the sensor was started on, for the init after a
+   power down. In that mode the sensor NVM cache is set to one kept here
+    @param  i2c I2C bus the sensor is located on
+    @param  vl_config Configuration the sensor was started with
+    @returns True if the estimate of the picked mode fits current_budget_ua.
+   When false, ranging still runs in the cheapest mode, unless the sensor
+   did not take the shortened timing budget, in which case nothing runs
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_DutyCycle::begin(
+    Adafruit_VL53L0X *sensor, uint32_t period_ms, uint32_t current_budget_ua,
+    int8_t shutdown_pin, uint8_t i2c_addr, TwoWire *i2c,
+    Adafruit_VL53L0X::VL53L0X_Sense_config_t vl_config) {
+  uint32_t budget_us;
+  boolean fits;
+
+  if ((sensor == NULL) || (period_ms == 0))
+    return false;
+
+  _sensor = sensor;
+  _period = period_ms;
+  _shutdownPin = shutdown_pin;
+  _i2cAddr = i2c_addr;
+  _i2c = i2c;
+  _config = vl_config;
+  _ranging = false;
+
+  budget_us = _sensor->getMeasurementTimingBudgetMicroSeconds();
+  if (_sensor->Status != VL53L0X_ERROR_NONE)
+    return false;
+
+  // ranging takes most of the charge, trade precision for current
+  fits = pickMode(budget_us, current_budget_ua);
+  while (!fits && (budget_us > 20000)) {
+    budget_us -= budget_us / 4;
+    if (budget_us < 20000)
+      budget_us = 20000;
+    fits = pickMode(budget_us, current_budget_ua);
+  }
+  if ((budget_us != _sensor->getMeasurementTimingBudgetMicroSeconds()) &&
+      !_sensor->setMeasurementTimingBudgetMicroSeconds(budget_us)) {
+    _sensor = NULL;
+    return false;
+  }
+  _budget = budget_us;
+
+  // a wake from XSHUT puts this back instead of calibrating again
+  if (_mode == VL53L0X_DUTY_SHUTDOWN) {
+    _refCalValid = _sensor->getRefCalibration(&_refCal);
+    _nvmInfo.Valid = 0;
+    _sensor->setNvmCache(&_nvmInfo);
+  }
+
+  // the first range is due straight away
+  _lastStart = millis() - _period;
+
+  switch (_mode) {
+  case VL53L0X_DUTY_TIMED:
+    _sensor->startRangeContinuous(_period > 0xffff ? 0xffff : _period);
+    break;
+  case VL53L0X_DUTY_STANDBY:
+    _sensor->standby();
+    break;
+  case VL53L0X_DUTY_SHUTDOWN:
+    pinMode(_shutdownPin, OUTPUT);
+    digitalWrite(_shutdownPin, LOW);
+    break;
+  }
+
+  return fits;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start, finish and put the sensor to sleep as needed without
+   blocking, except for the init when waking up from XSHUT. Call this
+   often from loop()
+    @returns True when a new range was delivered, see getRange()
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_DutyCycle::poll(void) {
+  boolean started;
+
+  if (_sensor == NULL)
+    return false;
+
+  if (_mode == VL53L0X_DUTY_TIMED) {
+    if (!_sensor->isRangeComplete())
+      return false;
+    _range = _sensor->readRangeResult();
+    _rangeStatus = _sensor->readRangeStatus();
+    return true;
+  }
+
+  if (!_ranging) {
+    if ((millis() - _lastStart) < _period)
+      return false;
+    _lastStart = millis();
+
+    if (_mode == VL53L0X_DUTY_STANDBY) {
+      started = _sensor->wake();
+    } else {
+      started = wakeFromShutdown();
+    }
+    if (started && _sensor->startRange()) {
+      _ranging = true;
+      return false;
+    }
+    // could not even start, report it
+    _range = 0xffff;
+    _rangeStatus = _sensor->readRangeStatus();
+  } else {
+    if (!_sensor->isRangeComplete())
+      return false;
+    _range = _sensor->readRangeResult();
+    _rangeStatus = _sensor->readRangeStatus();
+    _ranging = false;
+  }
+
+  if (_mode == VL53L0X_DUTY_STANDBY)
+    _sensor->standby();
+  else
+    digitalWrite(_shutdownPin, LOW);
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Stop duty cycling and leave the sensor idle and ready for the
+   other ranging functions
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_DutyCycle::end(void) {
+  if (_sensor == NULL)
+    return;
+
+  if (_ranging) {
+    _sensor->waitRangeComplete();
+    _sensor->readRangeResult();
+    _ranging = false;
+  }
+
+  switch (_mode) {
+  case VL53L0X_DUTY_TIMED:
+    _sensor->stopRangeContinuous();
+    break;
+  case VL53L0X_DUTY_STANDBY:
+    _sensor->wake();
+    break;
+  case VL53L0X_DUTY_SHUTDOWN:
+    if (digitalRead(_shutdownPin) == LOW)
+      wakeFromShutdown();
+    _sensor->setNvmCache(NULL); // the cache is ours
+    break;
+  }
+
+  _sensor = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Release XSHUT and bring the sensor back to where begin() left it.
+   The NVM is read from the cache and the reference calibration captured by
+   begin() is written back, only the data and static init run again
+    @returns True if the sensor is ready to range
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_DutyCycle::wakeFromShutdown(void) {
+  digitalWrite(_shutdownPin, HIGH);
+  delay(2); // firmware boot, 1.2 ms max
+
+  if (!_refCalValid) {
+    // nothing captured, calibrate again
+    return _sensor->begin(_i2cAddr, false, _i2c, _config) &&
+           _sensor->setMeasurementTimingBudgetMicroSeconds(_budget);
+  }
+
+  return _sensor->initSensor(_i2cAddr, false, _i2c) &&
+         _sensor->setRefCalibration(&_refCal) &&
+         _sensor->configSensor(_config) &&
+         _sensor->setMeasurementTimingBudgetMicroSeconds(_budget);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Estimate the sensor charge one range takes in a mode, idle time
+   until the next range included
+    @param  mode The mode
+    @param  budget_us Timing budget of the range
+    @param  period_ms Time between ranges
+    @returns charge in nC
+*/
+/**************************************************************************/
+uint32_t Adafruit_VL53L0X_DutyCycle::chargePerSample(VL53L0X_DutyMode_t mode,
+                                                     uint32_t budget_us,
+                                                     uint32_t period_ms) {
+  // uA * ms = nC
+  uint32_t ranging =
+      (uint32_t)VL53L0X_CURRENT_RANGING_UA * (budget_us / 100) / 10;
+  uint32_t budget_ms = (budget_us + 999) / 1000;
+  uint32_t idle_ms = (period_ms > budget_ms) ? period_ms - budget_ms : 0;
+
+  switch (mode) {
+  case VL53L0X_DUTY_TIMED:
+    return ranging + VL53L0X_CURRENT_TIMED_UA * idle_ms;
+  case VL53L0X_DUTY_STANDBY:
+    return ranging + VL53L0X_STANDBY_WAKE_NC +
+           VL53L0X_CURRENT_SW_STANDBY_UA * idle_ms;
+  default:
+    if (idle_ms < VL53L0X_SHUTDOWN_WAKE_MS)
+      return 0xffffffff; // can't keep up
+    idle_ms -= VL53L0X_SHUTDOWN_WAKE_MS;
+    return ranging + VL53L0X_SHUTDOWN_WAKE_NC +
+           VL53L0X_CURRENT_HW_STANDBY_UA * idle_ms;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Keep the mode with the lowest charge per range
+    @param  budget_us Timing budget of the ranges
+    @param  current_budget_ua Average current not to exceed
+    @returns True if that mode fits current_budget_ua
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_DutyCycle::pickMode(uint32_t budget_us,
+                                             uint32_t current_budget_ua) {
+  uint32_t charge;
+
+  _mode = VL53L0X_DUTY_TIMED;
+  _charge = chargePerSample(VL53L0X_DUTY_TIMED, budget_us, _period);
+
+  charge = chargePerSample(VL53L0X_DUTY_STANDBY, budget_us, _period);
+  if (charge < _charge) {
+    _mode = VL53L0X_DUTY_STANDBY;
+    _charge = charge;
+  }
+
+  if (_shutdownPin >= 0) {
+    charge = chargePerSample(VL53L0X_DUTY_SHUTDOWN, budget_us, _period);
+    if (charge < _charge) {
+      _mode = VL53L0X_DUTY_SHUTDOWN;
+      _charge = charge;
+    }
+  }
+
+  // average current, rounded up
+  return ((_charge + _period - 1) / _period <= current_budget_ua);
+}
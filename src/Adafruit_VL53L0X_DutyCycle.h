@@ -0,0 +1,135 @@
+/*!
+ * @file Adafruit_VL53L0X_DutyCycle.h
+
+  Low power, duty cycled ranging for the Adafruit VL53L0X library
+
+  Given a sample period and a current budget, picks the cheapest way to get
+  one range per period: timed continuous ranging, single ranges with the
+  sensor in software standby in between, or the sensor powered down with
+  XSHUT in between.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  BSD license, all text above must be included in any
+  redistribution
+ ****************************************************/
+
+#ifndef ADAFRUIT_VL53L0X_DUTYCYCLE_H
+#define ADAFRUIT_VL53L0X_DUTYCYCLE_H
+
+#include "Adafruit_VL53L0X.h"
+
+// Supply current estimates, typical values from the datasheet. Override
+// them with measured ones for a better choice of mode.
+#ifndef VL53L0X_CURRENT_RANGING_UA
+#define VL53L0X_CURRENT_RANGING_UA 19000 ///< Average while ranging
+#endif
+
+#ifndef VL53L0X_CURRENT_TIMED_UA
+#define VL53L0X_CURRENT_TIMED_UA 16 ///< Between timed continuous ranges
+#endif
+
+#ifndef VL53L0X_CURRENT_SW_STANDBY_UA
+#define VL53L0X_CURRENT_SW_STANDBY_UA 6 ///< Software standby
+#endif
+
+#ifndef VL53L0X_CURRENT_HW_STANDBY_UA
+#define VL53L0X_CURRENT_HW_STANDBY_UA 5 ///< XSHUT low
+#endif
+
+#ifndef VL53L0X_STANDBY_WAKE_NC
+#define VL53L0X_STANDBY_WAKE_NC 20 ///< Charge of a wake() and start over I2C
+#endif
+
+#ifndef VL53L0X_SHUTDOWN_WAKE_MS
+#define VL53L0X_SHUTDOWN_WAKE_MS 40 ///< Boot and init after XSHUT
+#endif
+
+#ifndef VL53L0X_SHUTDOWN_WAKE_NC
+#define VL53L0X_SHUTDOWN_WAKE_NC 200000 ///< Charge of boot and init
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Class that takes one range per period from a VL53L0X while
+   drawing as little current as it can
+*/
+/**************************************************************************/
+class Adafruit_VL53L0X_DutyCycle {
+public:
+  /** How the sensor spends the time between ranges */
+  typedef enum {
+    VL53L0X_DUTY_TIMED = 0, ///< timed continuous ranging
+    VL53L0X_DUTY_STANDBY,   ///< single ranges, software standby in between
+    VL53L0X_DUTY_SHUTDOWN   ///< single ranges, XSHUT low in between
+  } VL53L0X_DutyMode_t;
+
+  boolean begin(Adafruit_VL53L0X *sensor, uint32_t period_ms,
+                uint32_t current_budget_ua, int8_t shutdown_pin = -1,
+                uint8_t i2c_addr = VL53L0X_I2C_ADDR, TwoWire *i2c = &Wire,
+                Adafruit_VL53L0X::VL53L0X_Sense_config_t vl_config =
+                    Adafruit_VL53L0X::VL53L0X_SENSE_DEFAULT);
+  boolean poll(void);
+  void end(void);
+
+  static uint32_t chargePerSample(VL53L0X_DutyMode_t mode, uint32_t budget_us,
+                                  uint32_t period_ms);
+
+  /**************************************************************************/
+  /*!
+      @brief  The mode begin() picked
+      @returns mode
+  */
+  /**************************************************************************/
+  VL53L0X_DutyMode_t getMode(void) { return _mode; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Estimated sensor charge used per range in the picked mode
+      @returns charge in nC, divide by the period in ms for the average uA
+  */
+  /**************************************************************************/
+  uint32_t getChargePerSample(void) { return _charge; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Last range delivered
+      @returns Range in millimeters, 0xffff if invalid
+  */
+  /**************************************************************************/
+  uint16_t getRange(void) { return _range; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Range status of the last range delivered
+      @returns Range status, 0 when the range is valid
+  */
+  /**************************************************************************/
+  uint8_t getRangeStatus(void) { return _rangeStatus; }
+
+private:
+  boolean pickMode(uint32_t budget_us, uint32_t current_budget_ua);
+  boolean wakeFromShutdown(void);
+
+  Adafruit_VL53L0X *_sensor = NULL;
+  TwoWire *_i2c = NULL;
+  Adafruit_VL53L0X::VL53L0X_Sense_config_t _config =
+      Adafruit_VL53L0X::VL53L0X_SENSE_DEFAULT;
+  VL53L0X_DutyMode_t _mode = VL53L0X_DUTY_TIMED;
+  uint32_t _period = 0;
+  uint32_t _budget = 0;
+  uint32_t _charge = 0;
+  uint32_t _lastStart = 0;
+  int8_t _shutdownPin = -1;
+  uint8_t _i2cAddr = VL53L0X_I2C_ADDR;
+  boolean _ranging = false;
+  uint16_t _range = 0xffff;
+  uint8_t _rangeStatus = 0xff;
+  boolean _refCalValid = false;
+  Adafruit_VL53L0X::VL53L0X_RefCalibration_t _refCal;
+  VL53L0X_NvmInfo_t _nvmInfo;
+};
+
+#endif
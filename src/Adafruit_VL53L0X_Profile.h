@@ -0,0 +1,266 @@
+/*!
+ * @file Adafruit_VL53L0X_Profile.h
+
+  Compile time ranging profiles for the Adafruit VL53L0X library
+
+  Works out, with constexpr, the register image that
+  SetMeasurementTimingBudgetMicroSeconds(), SetVcselPulsePeriod() and the
+  limit check setters would leave in the device, so applying a profile is a
+  fixed list of register writes. Invalid combinations do not compile when
+  the profile is declared constexpr.
+
+  BSD license, all text above must be included in any
+  redistribution
+ ****************************************************/
+
+#ifndef ADAFRUIT_VL53L0X_PROFILE_H
+#define ADAFRUIT_VL53L0X_PROFILE_H
+
+#include "vl53l0x_def.h"
+
+#define VL53L0X_PROFILE_SEQUENCE_DEFAULT 0xE8 ///< Steps left by StaticInit
+#define VL53L0X_PROFILE_MSRC_TIMEOUT_DEFAULT 0x25 ///< MSRC timeout, tuning
+#define VL53L0X_PROFILE_PRE_RANGE_TIMEOUT_DEFAULT                              \
+  0x0096 ///< Pre-range timeout, tuning
+#define VL53L0X_PROFILE_VCSEL_PERIOD_DEFAULT 14 ///< Tuning pre-range period
+
+/** Called when a constexpr profile is invalid, which stops the compile */
+inline int VL53L0X_invalid_profile(void) { return 0; }
+
+/**************************************************************************/
+/*!
+    @brief  Builds VL53L0X_Profile_t images at compile time. All the timeout
+   arithmetic follows vl53l0x_api_core.cpp step by step, so a built profile
+   holds the same registers the runtime setters write
+*/
+/**************************************************************************/
+class Adafruit_VL53L0X_Profile {
+public:
+  /**************************************************************************/
+  /*!
+      @brief  Check the arguments of build() without building
+      @returns True if build() would give a valid profile
+  */
+  /**************************************************************************/
+  static constexpr bool
+  isValid(uint32_t budget_us, uint8_t pre_vcsel, uint8_t final_vcsel,
+          uint8_t sequence_config = VL53L0X_PROFILE_SEQUENCE_DEFAULT,
+          uint32_t msrc_us = defaultMsrcUs(),
+          uint32_t pre_range_us = defaultPreRangeUs()) {
+    return (budget_us >= 20000) && ((pre_vcsel & 1) == 0) &&
+           (pre_vcsel >= 12) && (pre_vcsel <= 18) &&
+           ((final_vcsel & 1) == 0) && (final_vcsel >= 8) &&
+           (final_vcsel <= 14) && (sequence_config & 0x80) &&
+           (budget_us - 2280 > tccTime(sequence_config, msrc_us, pre_vcsel)) &&
+           (afterTcc(budget_us, sequence_config, msrc_us, pre_vcsel) >
+            dssMsrcTime(sequence_config, msrc_us, pre_vcsel)) &&
+           (afterMsrc(budget_us, sequence_config, msrc_us, pre_vcsel) >
+            preTime(sequence_config, pre_range_us, pre_vcsel)) &&
+           (afterPre(budget_us, sequence_config, msrc_us, pre_range_us,
+                     pre_vcsel) > 550) &&
+           (finalMclks(budget_us, sequence_config, msrc_us, pre_range_us,
+                       pre_vcsel, final_vcsel) <= 0xFFFF);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief  Build a profile, use as
+        constexpr VL53L0X_Profile_t p = Adafruit_VL53L0X_Profile::build(...);
+      @param  budget_us Timing budget, 20000 us or more
+      @param  pre_vcsel Pre-range VCSEL period: 12, 14, 16 or 18
+      @param  final_vcsel Final range VCSEL period: 8, 10, 12 or 14
+      @param  signal_rate Signal rate final range limit, 16.16 MCPS, 0 to
+     disable the check
+      @param  sigma Sigma final range limit, 16.16 mm, 0 to disable
+      @param  ignore_threshold Range ignore threshold, 16.16 MCPS, 0 to
+     disable
+      @param  sequence_config SYSTEM_SEQUENCE_CONFIG, final range required
+      @param  msrc_us MSRC/TCC/DSS timeout
+      @param  pre_range_us Pre-range timeout
+      @returns The profile. Valid is 0 if the arguments are invalid, which
+     is a compile error for a constexpr profile
+  */
+  /**************************************************************************/
+  static constexpr VL53L0X_Profile_t
+  build(uint32_t budget_us, uint8_t pre_vcsel, uint8_t final_vcsel,
+        FixPoint1616_t signal_rate, FixPoint1616_t sigma,
+        FixPoint1616_t ignore_threshold = 0,
+        uint8_t sequence_config = VL53L0X_PROFILE_SEQUENCE_DEFAULT,
+        uint32_t msrc_us = defaultMsrcUs(),
+        uint32_t pre_range_us = defaultPreRangeUs()) {
+    return (isValid(budget_us, pre_vcsel, final_vcsel, sequence_config,
+                    msrc_us, pre_range_us)
+                ? 0
+                : VL53L0X_invalid_profile()),
+           VL53L0X_Profile_t{
+               (uint8_t)(isValid(budget_us, pre_vcsel, final_vcsel,
+                                 sequence_config, msrc_us, pre_range_us)
+                             ? VL53L0X_PROFILE_BUILT
+                             : 0),
+               pre_vcsel,
+               final_vcsel,
+               0,
+               (uint8_t)(final_vcsel == 8 ? 0x30 : 0x20),
+               {sequence_config, phasecalTimeout(final_vcsel),
+                (uint8_t)(final_vcsel == 8 ? 0x02 : 0x03),
+                (uint8_t)(fix97(signal_rate) >> 8),
+                (uint8_t)(fix97(signal_rate) & 0xFF),
+                msrcEncoded(msrc_us, pre_vcsel), 0x08,
+                finalPhaseHigh(final_vcsel),
+                vcselReg(pre_vcsel),
+                (uint8_t)(preEncoded(pre_range_us, pre_vcsel) >> 8),
+                (uint8_t)(preEncoded(pre_range_us, pre_vcsel) & 0xFF), 0x08,
+                prePhaseHigh(pre_vcsel),
+                0x12, // MSRC and pre-range signal checks off, as DataInit
+                0x00, 0x00, // and their limit, as the checks' values below
+                vcselReg(final_vcsel),
+                (uint8_t)(finalEncoded(budget_us, sequence_config, msrc_us,
+                                       pre_range_us, pre_vcsel, final_vcsel) >>
+                          8),
+                (uint8_t)(finalEncoded(budget_us, sequence_config, msrc_us,
+                                       pre_range_us, pre_vcsel, final_vcsel) &
+                          0xFF)},
+               {(uint8_t)(sigma != 0), (uint8_t)(signal_rate != 0), 0,
+                (uint8_t)(ignore_threshold != 0), 0, 0},
+               {sigma, signal_rate, (FixPoint1616_t)(35 * 65536),
+                ignore_threshold, 0, 0},
+               budget_us,
+               afterPre(budget_us, sequence_config, msrc_us, pre_range_us,
+                        pre_vcsel) -
+                   550,
+               pre_range_us,
+               msrcEncoded(msrc_us, pre_vcsel)};
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief  MSRC timeout the tuning settings leave in the device
+      @returns microseconds
+  */
+  /**************************************************************************/
+  static constexpr uint32_t defaultMsrcUs(void) {
+    return timeoutUs(VL53L0X_PROFILE_MSRC_TIMEOUT_DEFAULT + 1,
+                     VL53L0X_PROFILE_VCSEL_PERIOD_DEFAULT);
+  }
+
+  /**************************************************************************/
+  /*!
+      @brief  Pre-range timeout the tuning settings leave in the device
+      @returns microseconds
+  */
+  /**************************************************************************/
+  static constexpr uint32_t defaultPreRangeUs(void) {
+    return timeoutUs(decode(VL53L0X_PROFILE_PRE_RANGE_TIMEOUT_DEFAULT),
+                     VL53L0X_PROFILE_VCSEL_PERIOD_DEFAULT);
+  }
+
+private:
+  // VL53L0X_calc_macro_period_ps() rounded to ns
+  static constexpr uint32_t macroNs(uint8_t vcsel) {
+    return ((uint32_t)2304 * vcsel * 1655 + 500) / 1000;
+  }
+  // VL53L0X_calc_timeout_mclks()
+  static constexpr uint32_t mclks(uint32_t us, uint8_t vcsel) {
+    return (us * 1000 + macroNs(vcsel) / 2) / macroNs(vcsel);
+  }
+  // VL53L0X_calc_timeout_us()
+  static constexpr uint32_t timeoutUs(uint32_t mclks, uint8_t vcsel) {
+    return (mclks * macroNs(vcsel) + macroNs(vcsel) / 2) / 1000;
+  }
+  // VL53L0X_encode_timeout()
+  static constexpr uint16_t encode(uint32_t mclks) {
+    return mclks == 0 ? 0 : encodeShift(mclks - 1, 0);
+  }
+  static constexpr uint16_t encodeShift(uint32_t ls, uint16_t ms) {
+    return (ls & 0xFFFFFF00) ? encodeShift(ls >> 1, ms + 1)
+                             : (uint16_t)((ms << 8) + (ls & 0xFF));
+  }
+  // VL53L0X_decode_timeout()
+  static constexpr uint32_t decode(uint16_t encoded) {
+    return ((uint32_t)(encoded & 0xFF) << ((encoded & 0xFF00) >> 8)) + 1;
+  }
+  static constexpr uint16_t fix97(FixPoint1616_t value) {
+    return VL53L0X_FIXPOINT1616TOFIXPOINT97(value);
+  }
+  static constexpr uint8_t vcselReg(uint8_t vcsel) {
+    return (uint8_t)((vcsel >> 1) - 1);
+  }
+  // Phase settings of VL53L0X_set_vcsel_pulse_period()
+  static constexpr uint8_t prePhaseHigh(uint8_t vcsel) {
+    return vcsel == 12 ? 0x18 : vcsel == 14 ? 0x30 : vcsel == 16 ? 0x40 : 0x50;
+  }
+  static constexpr uint8_t finalPhaseHigh(uint8_t vcsel) {
+    return vcsel == 8 ? 0x10 : vcsel == 10 ? 0x28 : vcsel == 12 ? 0x38 : 0x48;
+  }
+  static constexpr uint8_t phasecalTimeout(uint8_t vcsel) {
+    return vcsel == 8 ? 0x0C : vcsel == 10 ? 0x09 : vcsel == 12 ? 0x08 : 0x07;
+  }
+
+  // set_sequence_step_timeout(), MSRC
+  static constexpr uint8_t msrcEncoded(uint32_t us, uint8_t vcsel) {
+    return (uint16_t)mclks(us, vcsel) > 256
+               ? 255
+               : (uint8_t)((uint8_t)(uint16_t)mclks(us, vcsel) - 1);
+  }
+  // set_sequence_step_timeout(), PRE_RANGE
+  static constexpr uint16_t preEncoded(uint32_t us, uint8_t vcsel) {
+    return encode((uint16_t)mclks(us, vcsel));
+  }
+  // what get_sequence_step_timeout() reads back
+  static constexpr uint32_t msrcActualUs(uint32_t us, uint8_t vcsel) {
+    return timeoutUs(msrcEncoded(us, vcsel) + 1, vcsel);
+  }
+  static constexpr uint32_t preActualUs(uint32_t us, uint8_t vcsel) {
+    return timeoutUs((uint16_t)decode(preEncoded(us, vcsel)), vcsel);
+  }
+
+  // VL53L0X_set_measurement_timing_budget_micro_seconds(), step by step
+  static constexpr uint32_t tccTime(uint8_t seq, uint32_t msrc_us,
+                                    uint8_t pre_vcsel) {
+    return (seq & 0x10) ? msrcActualUs(msrc_us, pre_vcsel) + 590 : 0;
+  }
+  static constexpr uint32_t dssMsrcTime(uint8_t seq, uint32_t msrc_us,
+                                        uint8_t pre_vcsel) {
+    return (seq & 0x08)   ? 2 * (msrcActualUs(msrc_us, pre_vcsel) + 690)
+           : (seq & 0x04) ? msrcActualUs(msrc_us, pre_vcsel) + 660
+                          : 0;
+  }
+  static constexpr uint32_t preTime(uint8_t seq, uint32_t pre_range_us,
+                                    uint8_t pre_vcsel) {
+    return (seq & 0x40) ? preActualUs(pre_range_us, pre_vcsel) + 660 : 0;
+  }
+  static constexpr uint32_t afterTcc(uint32_t budget_us, uint8_t seq,
+                                     uint32_t msrc_us, uint8_t pre_vcsel) {
+    return budget_us - 2280 - tccTime(seq, msrc_us, pre_vcsel);
+  }
+  static constexpr uint32_t afterMsrc(uint32_t budget_us, uint8_t seq,
+                                      uint32_t msrc_us, uint8_t pre_vcsel) {
+    return afterTcc(budget_us, seq, msrc_us, pre_vcsel) -
+           dssMsrcTime(seq, msrc_us, pre_vcsel);
+  }
+  static constexpr uint32_t afterPre(uint32_t budget_us, uint8_t seq,
+                                     uint32_t msrc_us, uint32_t pre_range_us,
+                                     uint8_t pre_vcsel) {
+    return afterMsrc(budget_us, seq, msrc_us, pre_vcsel) -
+           preTime(seq, pre_range_us, pre_vcsel);
+  }
+  // set_sequence_step_timeout(), FINAL_RANGE
+  static constexpr uint32_t finalMclks(uint32_t budget_us, uint8_t seq,
+                                       uint32_t msrc_us, uint32_t pre_range_us,
+                                       uint8_t pre_vcsel, uint8_t final_vcsel) {
+    return mclks(afterPre(budget_us, seq, msrc_us, pre_range_us, pre_vcsel) -
+                     550,
+                 final_vcsel) +
+           ((seq & 0x40) ? decode(preEncoded(pre_range_us, pre_vcsel)) : 0);
+  }
+  static constexpr uint16_t finalEncoded(uint32_t budget_us, uint8_t seq,
+                                         uint32_t msrc_us,
+                                         uint32_t pre_range_us,
+                                         uint8_t pre_vcsel,
+                                         uint8_t final_vcsel) {
+    return encode(finalMclks(budget_us, seq, msrc_us, pre_range_us, pre_vcsel,
+                             final_vcsel));
+  }
+};
+
+#endif
@@ -0,0 +1,673 @@
+/*!
+ * @file Adafruit_VL53L0X_Scheduler.cpp
+ *
+ * Multi-sensor, multi-bus ranging scheduler for the Adafruit VL53L0X library.
+ *
+ * Every I2C bus gets its own queue with at most one range in flight. poll()
+ * advances all of the queues without blocking, so while a sensor on Wire is
+ * integrating, a sensor on Wire1 is started, read and restarted. The time to
+ * sample the whole array therefore drops with the number of buses used.
+ *
+ * The VHV and phase calibrations drift with temperature. When due, a sensor
+ * runs them in place of its next range, one non-blocking step per poll(),
+ * and ranges as soon as they are over.
+ *
+ * A sensor that keeps failing is quarantined, so it stops holding up its bus
+ * queue and the cycles, for a back-off that doubles each time it relapses.
+ * When the back-off is over it is pulsed through XSHUT, given its address
+ * back and its saved reference calibration, again one step per poll().
+ *
+ * BSD license, all text here must be included in any redistribution.
+ *
+ */
+
+#include "Adafruit_VL53L0X_Scheduler.h"
+
+/**************************************************************************/
+/*!
+    @brief  Add a sensor, that has already been started with begin(), to the
+   scheduler
+    @param  sensor The sensor object
+    @param  i2c The I2C bus the sensor was started on. Default is Wire
+    @returns True if the sensor was added, false if the scheduler is full
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::addSensor(Adafruit_VL53L0X *sensor,
+                                              TwoWire *i2c) {
+  uint8_t bus;
+
+  if ((sensor == NULL) || (_sensorCount >= VL53L0X_SCHEDULER_MAX_SENSORS))
+    return false;
+
+  for (bus = 0; bus < _busCount; bus++) {
+    if (_buses[bus].i2c == i2c)
+      break;
+  }
+
+  if (bus == _busCount) {
+    if (_busCount >= VL53L0X_SCHEDULER_MAX_BUSES)
+      return false;
+    _buses[bus].i2c = i2c;
+    _buses[bus].active = -1;
+    _buses[bus].next = 0;
+    _busCount++;
+  }
+
+  _sensors[_sensorCount].sensor = sensor;
+  _sensors[_sensorCount].bus = bus;
+  _sensors[_sensorCount].range = 0xffff;
+  _sensors[_sensorCount].rangeStatus = 0;
+  _sensors[_sensorCount].i2cAddr = 0;
+  _sensors[_sensorCount].shutdownPin = -1;
+  _sensors[_sensorCount].config = Adafruit_VL53L0X::VL53L0X_SENSE_DEFAULT;
+  _sensors[_sensorCount].calibrating = false;
+  _sensors[_sensorCount].recalibrated = false;
+  memset(&_sensors[_sensorCount].health, 0, sizeof(VL53L0X_SensorHealth_t));
+  _sensors[_sensorCount].refCalValid = false;
+  _sensorCount++;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Add a sensor that has not been started yet, beginAll() will
+   bring it up together with the other sensors
+    @param  sensor The sensor object
+    @param  i2c The I2C bus the sensor is located on
+    @param  i2c_addr The address to move the sensor to. Pick any number but
+   0x29, under 0x7F and different for every sensor on the same bus
+    @param  shutdown_pin Pin wired to the XSHUT line of the sensor, -1 if none.
+   Only one sensor per bus can do without one
+    @param  vl_config Sensor configuration applied once calibrated
+    @returns True if the sensor was added, false if the scheduler is full
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::addSensor(
+    Adafruit_VL53L0X *sensor, TwoWire *i2c, uint8_t i2c_addr,
+    int8_t shutdown_pin, Adafruit_VL53L0X::VL53L0X_Sense_config_t vl_config) {
+  if (!addSensor(sensor, i2c))
+    return false;
+
+  _sensors[_sensorCount - 1].i2cAddr = i2c_addr;
+  _sensors[_sensorCount - 1].shutdownPin = shutdown_pin;
+  _sensors[_sensorCount - 1].config = vl_config;
+
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start every sensor that was added with an address. The sensors
+   are taken out of XSHUT one by one to give them their address, then the
+   reference SPAD management and reference calibration of all of them run
+   at the same time, so booting N sensors takes about as long as one. With
+   VL53L0X_SLIM they share one calibration state and calibrate in turn.
+   A calibration that takes longer than VL53L0X_SCHEDULER_CAL_TIMEOUT_MS
+   fails its sensor
+    @param debug Optional debug flag. If true, debug information will print out
+   via Serial.print during setup. Defaults to false.
+    @returns Number of sensors that were started
+*/
+/**************************************************************************/
+uint8_t Adafruit_VL53L0X_Scheduler::beginAll(boolean debug) {
+  uint32_t waiting = 0;
+  uint32_t calibrating = 0;
+  uint8_t started = 0;
+  uint8_t i;
+
+  // Hold every sensor we have a shutdown pin for in reset
+  for (i = 0; i < _sensorCount; i++) {
+    if ((_sensors[i].i2cAddr == 0) || (_sensors[i].shutdownPin < 0))
+      continue;
+    pinMode(_sensors[i].shutdownPin, OUTPUT);
+    digitalWrite(_sensors[i].shutdownPin, LOW);
+  }
+  delay(10);
+
+  // One by one wake them up and move them to their address. This part only
+  // talks over I2C, there is nothing to gain by overlapping it.
+  for (i = 0; i < _sensorCount; i++) {
+    sensor_slot_t *slot = &_sensors[i];
+
+    if (slot->i2cAddr == 0)
+      continue;
+    if (slot->shutdownPin >= 0) {
+      digitalWrite(slot->shutdownPin, HIGH);
+      delay(10); // give time to wake up.
+    }
+    if (slot->sensor->initSensor(slot->i2cAddr, debug,
+                                 _buses[slot->bus].i2c)) {
+      waiting |= ((uint32_t)1 << i);
+    } else if (debug) {
+      Serial.print(i, DEC);
+      Serial.println(F(": failed to start"));
+    }
+  }
+
+  // Now issue each sensor's next calibration step while the others are
+  // busy measuring
+  while (waiting || calibrating) {
+    for (i = 0; i < _sensorCount; i++) {
+      sensor_slot_t *slot = &_sensors[i];
+      uint32_t bit = (uint32_t)1 << i;
+
+      if (waiting & bit) {
+        // only fails with VL53L0X_SLIM, while another one calibrates
+        if (!slot->sensor->startCalibration())
+          continue;
+        waiting &= ~bit;
+        calibrating |= bit;
+        setHealthState(slot, VL53L0X_HEALTH_CALIBRATING);
+      }
+
+      if (!(calibrating & bit))
+        continue;
+      if ((millis() - slot->healthTime) > VL53L0X_SCHEDULER_CAL_TIMEOUT_MS)
+        slot->sensor->abortCalibration();
+      else if (!slot->sensor->calibrationStep())
+        continue;
+
+      calibrating &= ~bit;
+      setHealthState(slot, VL53L0X_HEALTH_OK);
+      if ((slot->sensor->Status == VL53L0X_ERROR_NONE) &&
+          slot->sensor->configSensor(slot->config)) {
+        started++;
+      } else if (debug) {
+        Serial.print(i, DEC);
+        Serial.print(F(": failed to calibrate, error "));
+        Serial.println(slot->sensor->Status);
+      }
+    }
+
+    if (waiting && !calibrating) {
+      // the shared calibration state is held by a sensor we do not manage
+      if (debug) {
+        Serial.println(F("calibration state in use elsewhere"));
+      }
+      break;
+    }
+  }
+
+  return started;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Set a function to be called each time a sensor delivers a sample
+    @param  callback The function, or NULL to disable
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::setCallback(range_callback_t callback) {
+  _callback = callback;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Reset all bus queues and start the first range on every bus.
+   Quarantined sensors are tried again straight away, sensors in the middle
+   of a recovery finish it first
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::start(void) {
+  _pending = ((uint32_t)1 << _sensorCount) - 1;
+  _cycleStart = millis();
+  _cycleCount = 0;
+  _calCount = 0;
+  _calGap = 0;
+
+  for (uint8_t i = 0; i < _sensorCount; i++) {
+    _sensors[i].calibrating = false;
+    _sensors[i].recalibrated = false;
+    _sensors[i].lastCal = _cycleStart;
+    _sensors[i].lastSample = micros();
+    _sensors[i].lastInterval = 0;
+    _sensors[i].refBase = 0;
+    _sensors[i].refCount = 0;
+    // a recovery under way, maybe with XSHUT low, is carried on by poll()
+    if (_sensors[i].health.state > VL53L0X_HEALTH_QUARANTINED)
+      continue;
+    _sensors[i].health.state = VL53L0X_HEALTH_OK;
+    _sensors[i].health.errorStreak = 0;
+    _sensors[i].health.timeoutStreak = 0;
+    _sensors[i].health.lastGood = _cycleStart;
+    _sensors[i].health.backoff = 0;
+  }
+
+  for (uint8_t bus = 0; bus < _busCount; bus++) {
+    _buses[bus].active = -1;
+    _buses[bus].next = 0;
+    startNext(bus);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Advance every bus queue without blocking. Call this often from
+   loop()
+    @returns True when the last sensor of a cycle delivered its sample, in
+   which case getRange() holds a complete, fresh set of values
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::poll(void) {
+  boolean cycle_done = false;
+  uint8_t bus;
+
+  if (_sensorCount == 0)
+    return false;
+
+  for (bus = 0; bus < _busCount; bus++) {
+    bus_queue_t *queue = &_buses[bus];
+    boolean timed_out = false;
+
+    if (queue->active < 0)
+      continue;
+
+    sensor_slot_t *slot = &_sensors[queue->active];
+    if (slot->calibrating) {
+      // a calibration that stalls is a range that never completed
+      if ((millis() - queue->startTime) > VL53L0X_SCHEDULER_CAL_TIMEOUT_MS) {
+        slot->sensor->abortCalibration();
+        timed_out = true;
+      } else if (!slot->sensor->calibrationStep()) {
+        continue;
+      }
+      // over, failed or not, the sensor still owes its sample of the cycle
+      slot->calibrating = false;
+      slot->recalibrated = true;
+      slot->lastCal = millis();
+      slot->refBase = 0;
+      slot->refCount = 0;
+      slot->refCalValid = false;
+      _calCount++;
+      if (slot->sensor->Status != VL53L0X_ERROR_NONE)
+        trackHealth(slot, timed_out);
+      queue->active = -1;
+      continue;
+    }
+
+    if (slot->sensor->isRangeComplete()) {
+      slot->range = slot->sensor->readRangeResult();
+    } else if ((millis() - queue->startTime) > VL53L0X_SCHEDULER_TIMEOUT_MS) {
+      slot->range = 0xffff;
+      timed_out = true;
+    } else {
+      continue;
+    }
+    slot->rangeStatus = slot->sensor->readRangeStatus();
+    trackSample(slot);
+    trackHealth(slot, timed_out);
+
+    _pending &= ~((uint32_t)1 << queue->active);
+    if (_callback)
+      _callback(queue->active, slot->range, slot->rangeStatus);
+    queue->active = -1;
+  }
+
+  if (!_pending) {
+    // every sensor reported, roll over to the next cycle on all buses
+    uint32_t now = millis();
+    _cycleTime = now - _cycleStart;
+    _cycleStart = now;
+    _cycleCount++;
+    _pending = ((uint32_t)1 << _sensorCount) - 1;
+    cycle_done = true;
+  }
+
+  // one recovery step per poll(), the recovering sensors take turns
+  for (uint8_t n = 0; n < _sensorCount; n++) {
+    uint8_t i = (_recoverNext + n) % _sensorCount;
+
+    if ((_sensors[i].health.state != VL53L0X_HEALTH_OK) && recover(i)) {
+      _recoverNext = i + 1;
+      break;
+    }
+  }
+
+  for (bus = 0; bus < _busCount; bus++) {
+    if (_buses[bus].active < 0)
+      startNext(bus);
+  }
+
+  return cycle_done;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Rerun the VHV and phase calibration of a sensor between two of
+   its ranges when it is due, without stopping the other sensors
+    @param  interval_ms Recalibrate after this long, 0 for never
+    @param  drift_percent Recalibrate when the average reference signal rate
+   moved this much since the last calibration, 0 for never. The rate
+   follows the VCSEL output, so it tracks the temperature of the sensor
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::setRecalibration(uint32_t interval_ms,
+                                                  uint8_t drift_percent) {
+  _calInterval = interval_ms;
+  _calDrift = drift_percent;
+
+  for (uint8_t i = 0; i < _sensorCount; i++)
+    _sensors[i].lastCal = millis();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the last range delivered by a sensor
+    @param  index Index of the sensor, in the order it was added
+    @returns Range in millimeters, 0xffff if invalid
+*/
+/**************************************************************************/
+uint16_t Adafruit_VL53L0X_Scheduler::getRange(uint8_t index) {
+  if (index >= _sensorCount)
+    return 0xffff;
+  return _sensors[index].range;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the range status of the last sample delivered by a sensor
+    @param  index Index of the sensor, in the order it was added
+    @returns Range status, 0 when the range is valid
+*/
+/**************************************************************************/
+uint8_t Adafruit_VL53L0X_Scheduler::getRangeStatus(uint8_t index) {
+  if (index >= _sensorCount)
+    return 0xff;
+  return _sensors[index].rangeStatus;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the health of a sensor as seen by the watchdog
+    @param  index Index of the sensor, in the order it was added
+    @param  health Where to store it
+    @returns False if there is no such sensor
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::getHealth(uint8_t index,
+                                              VL53L0X_SensorHealth_t *health) {
+  if (index >= _sensorCount)
+    return false;
+  *health = _sensors[index].health;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a range on the next sensor of a bus that still owes a
+   sample in the current cycle
+    @param  bus Index of the bus queue
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::startNext(uint8_t bus) {
+  bus_queue_t *queue = &_buses[bus];
+
+  queue->active = -1;
+  for (uint8_t n = 0; n < _sensorCount; n++) {
+    uint8_t i = (queue->next + n) % _sensorCount;
+
+    if ((_sensors[i].bus != bus) || !(_pending & ((uint32_t)1 << i)))
+      continue;
+
+    // a sick sensor sits the cycle out, the others keep their rate
+    if (_sensors[i].health.state != VL53L0X_HEALTH_OK) {
+      _pending &= ~((uint32_t)1 << i);
+      continue;
+    }
+
+    queue->next = i + 1;
+    if (recalibrationDue(&_sensors[i]) &&
+        _sensors[i].sensor->startCalibration(false)) {
+      _sensors[i].calibrating = true;
+      queue->active = i;
+      queue->startTime = millis();
+      return;
+    }
+
+    if (_sensors[i].sensor->startRange()) {
+      queue->active = i;
+      queue->startTime = millis();
+      return;
+    }
+
+    // could not even start, report it and move on to the next one
+    _sensors[i].range = 0xffff;
+    _sensors[i].rangeStatus = _sensors[i].sensor->readRangeStatus();
+    trackHealth(&_sensors[i], false);
+    _pending &= ~((uint32_t)1 << i);
+    if (_callback)
+      _callback(i, 0xffff, _sensors[i].rangeStatus);
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check whether a sensor should recalibrate instead of ranging
+    @param  slot The sensor
+    @returns True if the interval is over or the reference rate drifted
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::recalibrationDue(sensor_slot_t *slot) {
+  FixPoint1616_t drift;
+
+  if (_calInterval && ((millis() - slot->lastCal) >= _calInterval))
+    return true;
+
+  if (!_calDrift || (slot->refBase == 0))
+    return false;
+
+  drift = (slot->refAverage > slot->refBase)
+              ? slot->refAverage - slot->refBase
+              : slot->refBase - slot->refAverage;
+  return (drift * 100 > slot->refBase * _calDrift);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Book keeping after a sensor delivered a sample: the gap around
+   a recalibration and the running average of the reference signal rate
+    @param  slot The sensor
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::trackSample(sensor_slot_t *slot) {
+  uint32_t now = micros();
+  uint32_t interval = now - slot->lastSample;
+  int32_t delta;
+
+  if (slot->recalibrated) {
+    if ((interval > slot->lastInterval) &&
+        (interval - slot->lastInterval > _calGap))
+      _calGap = interval - slot->lastInterval;
+    slot->recalibrated = false;
+  } else {
+    slot->lastInterval = interval;
+  }
+  slot->lastSample = now;
+
+  if (!_calDrift || (slot->rangeStatus != 0))
+    return;
+
+  delta = (int32_t)slot->sensor->getReferenceSignalRate() -
+          (int32_t)slot->refAverage;
+  if (slot->refCount == 0)
+    slot->refAverage = slot->sensor->getReferenceSignalRate();
+  else
+    slot->refAverage += delta / VL53L0X_SCHEDULER_DRIFT_SAMPLES;
+
+  // the rate right after a calibration is what drift is measured against
+  if ((slot->refCount < VL53L0X_SCHEDULER_DRIFT_SAMPLES) &&
+      (++slot->refCount == VL53L0X_SCHEDULER_DRIFT_SAMPLES))
+    slot->refBase = slot->refAverage;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Health book keeping after a sensor delivered a sample or failed
+   to. A sensor is quarantined after VL53L0X_SCHEDULER_FAIL_LIMIT failures
+   in a row, or straight away after a range that never completed, which
+   already held its bus queue for VL53L0X_SCHEDULER_TIMEOUT_MS
+    @param  slot The sensor
+    @param  timed_out The range did not complete in time
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::trackHealth(sensor_slot_t *slot,
+                                             boolean timed_out) {
+  VL53L0X_SensorHealth_t *health = &slot->health;
+
+  if (!timed_out && (slot->sensor->Status == VL53L0X_ERROR_NONE)) {
+    health->errorStreak = 0;
+    health->timeoutStreak = 0;
+    health->lastGood = millis();
+    health->backoff = 0;
+    // what a recovery restores instead of calibrating again
+    if (!slot->refCalValid)
+      slot->refCalValid = slot->sensor->getRefCalibration(&slot->refCal);
+    return;
+  }
+
+  if (health->errorStreak < 0xff)
+    health->errorStreak++;
+  if (timed_out && (health->timeoutStreak < 0xff))
+    health->timeoutStreak++;
+
+  if (timed_out || (health->errorStreak >= VL53L0X_SCHEDULER_FAIL_LIMIT))
+    quarantine(slot);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Leave a sensor out of the cycles for a while, twice as long as
+   the last time if it did not deliver a good sample since
+    @param  slot The sensor
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::quarantine(sensor_slot_t *slot) {
+  uint32_t backoff = slot->health.backoff;
+
+  if (backoff == 0)
+    backoff = VL53L0X_SCHEDULER_BACKOFF_MS;
+  else if (backoff < VL53L0X_SCHEDULER_MAX_BACKOFF_MS / 2)
+    backoff *= 2;
+  else
+    backoff = VL53L0X_SCHEDULER_MAX_BACKOFF_MS;
+
+  slot->health.backoff = backoff;
+  slot->range = 0xffff;
+  setHealthState(slot, VL53L0X_HEALTH_QUARANTINED);
+}
+
+/**************************************************************************/
+/*!
+    @brief  Take a quarantined sensor one step closer to ranging again,
+   without waiting. Once the back-off is over, a sensor with an address and
+   an XSHUT pin is reset, initialized one initStep() at a time, moved back
+   to its address and given its saved reference calibration, or calibrated
+   again if none was saved. Others are simply tried again
+    @param  index Index of the sensor
+    @returns True if a step was run, false if the sensor is still waiting
+*/
+/**************************************************************************/
+boolean Adafruit_VL53L0X_Scheduler::recover(uint8_t index) {
+  sensor_slot_t *slot = &_sensors[index];
+  Adafruit_VL53L0X *sensor = slot->sensor;
+  uint32_t elapsed = millis() - slot->healthTime;
+  boolean resettable;
+
+  switch (slot->health.state) {
+  case VL53L0X_HEALTH_QUARANTINED:
+    if (elapsed < slot->health.backoff)
+      return false;
+
+    // it boots on the default address, which must be free on its bus
+    resettable = (slot->shutdownPin >= 0) && (slot->i2cAddr != 0);
+    for (uint8_t i = 0; resettable && (i < _sensorCount); i++) {
+      if ((i != index) && (_sensors[i].bus == slot->bus) &&
+          ((_sensors[i].i2cAddr == 0) ||
+           (_sensors[i].i2cAddr == VL53L0X_I2C_ADDR)))
+        resettable = false;
+    }
+    if (!resettable) {
+      // nothing else to try, one more failure quarantines it again
+      setHealthState(slot, VL53L0X_HEALTH_OK);
+      return true;
+    }
+    digitalWrite(slot->shutdownPin, LOW);
+    setHealthState(slot, VL53L0X_HEALTH_RESETTING);
+    return true;
+
+  case VL53L0X_HEALTH_RESETTING:
+    if (elapsed < 2)
+      return false;
+    digitalWrite(slot->shutdownPin, HIGH);
+    setHealthState(slot, VL53L0X_HEALTH_BOOTING);
+    return true;
+
+  case VL53L0X_HEALTH_BOOTING:
+    if (elapsed < 2) // firmware boot, 1.2 ms max
+      return false;
+    if (!sensor->startInit(slot->i2cAddr, false, _buses[slot->bus].i2c)) {
+      quarantine(slot);
+      return true;
+    }
+    setHealthState(slot, VL53L0X_HEALTH_INITIALIZING);
+    return true;
+
+  case VL53L0X_HEALTH_INITIALIZING:
+    if (!sensor->initStep())
+      return true;
+    if (sensor->Status != VL53L0X_ERROR_NONE) {
+      quarantine(slot);
+    } else if (slot->refCalValid) {
+      if (sensor->setRefCalibration(&slot->refCal))
+        setHealthState(slot, VL53L0X_HEALTH_CONFIGURING);
+      else
+        quarantine(slot);
+    } else if (sensor->startCalibration()) {
+      setHealthState(slot, VL53L0X_HEALTH_CALIBRATING);
+    } else {
+      // includes a slim build with the shared calibration state in use,
+      // tried again after the back-off
+      quarantine(slot);
+    }
+    return true;
+
+  case VL53L0X_HEALTH_CALIBRATING:
+    if (elapsed > VL53L0X_SCHEDULER_CAL_TIMEOUT_MS)
+      sensor->abortCalibration();
+    else if (!sensor->calibrationStep())
+      return true;
+    if (sensor->Status == VL53L0X_ERROR_NONE)
+      setHealthState(slot, VL53L0X_HEALTH_CONFIGURING);
+    else
+      quarantine(slot);
+    return true;
+
+  case VL53L0X_HEALTH_CONFIGURING:
+    if (sensor->configSensor(slot->config)) {
+      // back in the cycles, the streak stays until a good sample
+      slot->health.recoveries++;
+      slot->lastCal = millis();
+      setHealthState(slot, VL53L0X_HEALTH_OK);
+    } else {
+      quarantine(slot);
+    }
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Move a sensor to another health state
+    @param  slot The sensor
+    @param  state The new state
+*/
+/**************************************************************************/
+void Adafruit_VL53L0X_Scheduler::setHealthState(sensor_slot_t *slot,
+                                                VL53L0X_HealthState_t state) {
+  slot->health.state = state;
+  slot->healthTime = millis();
+}
@@ -0,0 +1,225 @@
+/*!
+ * @file Adafruit_VL53L0X_Scheduler.h
+
+  Multi-sensor, multi-bus ranging scheduler for the Adafruit VL53L0X library
+
+  Groups Adafruit_VL53L0X instances by the I2C bus they live on and runs one
+  independent measurement queue per bus, so sensors on Wire and Wire1 range
+  at the same time instead of one after another.
+
+  Adafruit invests time and resources providing this open source code,
+  please support Adafruit and open-source hardware by purchasing
+  products from Adafruit!
+
+  BSD license, all text above must be included in any
+  redistribution
+ ****************************************************/
+
+#ifndef ADAFRUIT_VL53L0X_SCHEDULER_H
+#define ADAFRUIT_VL53L0X_SCHEDULER_H
+
+#include "Adafruit_VL53L0X.h"
+
+#ifndef VL53L0X_SCHEDULER_MAX_SENSORS
+#define VL53L0X_SCHEDULER_MAX_SENSORS 8 ///< Max sensors one scheduler manages
+#endif
+
+// one bit per sensor in the uint32_t masks, and 1 << count must stay defined
+#if VL53L0X_SCHEDULER_MAX_SENSORS > 31
+#error "VL53L0X_SCHEDULER_MAX_SENSORS must be 31 or less"
+#endif
+
+#ifndef VL53L0X_SCHEDULER_MAX_BUSES
+#define VL53L0X_SCHEDULER_MAX_BUSES 4 ///< Max distinct I2C buses
+#endif
+
+#ifndef VL53L0X_SCHEDULER_TIMEOUT_MS
+#define VL53L0X_SCHEDULER_TIMEOUT_MS 1000 ///< Give up on a range after this
+#endif
+
+#ifndef VL53L0X_SCHEDULER_CAL_TIMEOUT_MS
+#define VL53L0X_SCHEDULER_CAL_TIMEOUT_MS 2000 ///< Give up on a calibration
+#endif
+
+#ifndef VL53L0X_SCHEDULER_DRIFT_SAMPLES
+#define VL53L0X_SCHEDULER_DRIFT_SAMPLES 8 ///< Ranges averaged for drift
+#endif
+
+#ifndef VL53L0X_SCHEDULER_FAIL_LIMIT
+#define VL53L0X_SCHEDULER_FAIL_LIMIT 3 ///< Failures in a row to quarantine
+#endif
+
+#ifndef VL53L0X_SCHEDULER_BACKOFF_MS
+#define VL53L0X_SCHEDULER_BACKOFF_MS 100 ///< First quarantine, doubles after
+#endif
+
+#ifndef VL53L0X_SCHEDULER_MAX_BACKOFF_MS
+#define VL53L0X_SCHEDULER_MAX_BACKOFF_MS 60000 ///< Longest quarantine
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Class that interleaves ranging of several VL53L0X sensors, one
+   queue per I2C bus
+*/
+/**************************************************************************/
+class Adafruit_VL53L0X_Scheduler {
+public:
+  /**************************************************************************/
+  /*!
+      @brief  Callback invoked each time a sensor delivers a sample
+      @param  index Index of the sensor, in the order it was added
+      @param  range_mm Range in millimeters, 0xffff if invalid
+      @param  range_status Range status from the measurement
+  */
+  /**************************************************************************/
+  typedef void (*range_callback_t)(uint8_t index, uint16_t range_mm,
+                                   uint8_t range_status);
+
+  /** Where a sensor stands with the health watchdog */
+  typedef enum {
+    VL53L0X_HEALTH_OK = 0,       ///< ranging
+    VL53L0X_HEALTH_QUARANTINED,  ///< left out until its back-off is over
+    VL53L0X_HEALTH_RESETTING,    ///< XSHUT held low
+    VL53L0X_HEALTH_BOOTING,      ///< XSHUT released, firmware booting
+    VL53L0X_HEALTH_INITIALIZING, ///< running the init one step per poll()
+    VL53L0X_HEALTH_CALIBRATING,  ///< restarted, no calibration to restore
+    VL53L0X_HEALTH_CONFIGURING   ///< calibrated, applying the configuration
+  } VL53L0X_HealthState_t;
+
+  /** Health of one sensor */
+  typedef struct {
+    VL53L0X_HealthState_t state; ///< ranging, quarantined or recovering
+    uint8_t errorStreak;         ///< failed samples in a row, saturates
+    uint8_t timeoutStreak;       ///< of those, ranges that never completed
+    uint32_t lastGood;           ///< millis() at the last good sample
+    uint32_t backoff;            ///< quarantine length in ms, 0 if healthy
+    uint16_t recoveries;         ///< times the sensor was brought back
+  } VL53L0X_SensorHealth_t;
+
+  boolean addSensor(Adafruit_VL53L0X *sensor, TwoWire *i2c = &Wire);
+  boolean addSensor(Adafruit_VL53L0X *sensor, TwoWire *i2c, uint8_t i2c_addr,
+                    int8_t shutdown_pin,
+                    Adafruit_VL53L0X::VL53L0X_Sense_config_t vl_config =
+                        Adafruit_VL53L0X::VL53L0X_SENSE_DEFAULT);
+  uint8_t beginAll(boolean debug = false);
+  void setCallback(range_callback_t callback);
+
+  void start(void);
+  boolean poll(void);
+
+  void setRecalibration(uint32_t interval_ms, uint8_t drift_percent = 0);
+
+  /**************************************************************************/
+  /*!
+      @brief  Number of reference recalibrations run since start()
+      @returns recalibration count
+  */
+  /**************************************************************************/
+  uint32_t getRecalibrationCount(void) { return _calCount; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Worst delay a recalibration added to the samples of a sensor:
+   the time between the samples around it, less the time between the two
+   samples before
+      @returns gap in microseconds
+  */
+  /**************************************************************************/
+  uint32_t getRecalibrationGap(void) { return _calGap; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Number of sensors handled by the scheduler
+      @returns sensor count
+  */
+  /**************************************************************************/
+  uint8_t sensorCount(void) { return _sensorCount; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Number of distinct I2C buses the sensors are spread over
+      @returns bus count
+  */
+  /**************************************************************************/
+  uint8_t busCount(void) { return _busCount; }
+
+  uint16_t getRange(uint8_t index);
+  uint8_t getRangeStatus(uint8_t index);
+  boolean getHealth(uint8_t index, VL53L0X_SensorHealth_t *health);
+
+  /**************************************************************************/
+  /*!
+      @brief  Time it took every sensor to deliver one sample, last cycle
+      @returns cycle time in milliseconds
+  */
+  /**************************************************************************/
+  uint32_t getCycleTime(void) { return _cycleTime; }
+
+  /**************************************************************************/
+  /*!
+      @brief  Number of complete cycles since start()
+      @returns cycle count
+  */
+  /**************************************************************************/
+  uint32_t getCycleCount(void) { return _cycleCount; }
+
+private:
+  /** Per sensor bookkeeping */
+  typedef struct {
+    Adafruit_VL53L0X *sensor; ///< sensor object
+    uint8_t bus;              ///< index into _buses
+    uint8_t rangeStatus;      ///< status from last sample
+    uint16_t range;           ///< last sample in mm
+    uint8_t i2cAddr;          ///< address given by beginAll(), 0 if none
+    int8_t shutdownPin;       ///< XSHUT pin, -1 if not wired
+    Adafruit_VL53L0X::VL53L0X_Sense_config_t config; ///< for beginAll()
+    boolean calibrating;       ///< running a recalibration instead of a range
+    boolean recalibrated;      ///< recalibrated since the last sample
+    uint32_t lastCal;          ///< millis() at the end of the last calibration
+    uint32_t lastSample;       ///< micros() at the last sample
+    uint32_t lastInterval;     ///< micros() between the last two samples
+    FixPoint1616_t refBase;    ///< reference signal rate after calibration
+    FixPoint1616_t refAverage; ///< running average of the reference rate
+    uint8_t refCount;          ///< samples in refAverage, up to DRIFT_SAMPLES
+    VL53L0X_SensorHealth_t health; ///< watchdog state
+    uint32_t healthTime;           ///< millis() when health.state was entered
+    Adafruit_VL53L0X::VL53L0X_RefCalibration_t refCal; ///< for recovery
+    boolean refCalValid; ///< refCal matches the sensor calibration
+  } sensor_slot_t;
+
+  /** Per bus queue */
+  typedef struct {
+    TwoWire *i2c;       ///< the bus
+    int8_t active;      ///< sensor with a range in flight, -1 if none
+    uint8_t next;       ///< where to resume searching for the next sensor
+    uint32_t startTime; ///< millis() when the active range was started
+  } bus_queue_t;
+
+  void startNext(uint8_t bus);
+  boolean recalibrationDue(sensor_slot_t *slot);
+  void trackSample(sensor_slot_t *slot);
+  void trackHealth(sensor_slot_t *slot, boolean timed_out);
+  void quarantine(sensor_slot_t *slot);
+  boolean recover(uint8_t index);
+  void setHealthState(sensor_slot_t *slot, VL53L0X_HealthState_t state);
+
+  sensor_slot_t _sensors[VL53L0X_SCHEDULER_MAX_SENSORS];
+  bus_queue_t _buses[VL53L0X_SCHEDULER_MAX_BUSES];
+  uint8_t _sensorCount = 0;
+  uint8_t _busCount = 0;
+  uint8_t _recoverNext = 0;
+
+  range_callback_t _callback = NULL;
+  uint32_t _pending = 0;
+  uint32_t _cycleStart = 0;
+  uint32_t _cycleTime = 0;
+  uint32_t _cycleCount = 0;
+
+  uint32_t _calInterval = 0;
+  uint8_t _calDrift = 0;
+  uint32_t _calCount = 0;
+  uint32_t _calGap = 0;
+};
+
+#endif
@@ -186,6 +186,8 @@ VL53L0X_Error VL53L0X_SetPowerMode(VL53L0X_DEV Dev,
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   LOG_FUNCTION_START("");
 
+  PALDevDataSet(Dev, SingleRangingPrepared, 0);
+
   /* Only level1 of Power mode exists */
   if ((PowerMode != VL53L0X_POWERMODE_STANDBY_LEVEL1) &&
       (PowerMode != VL53L0X_POWERMODE_IDLE_LEVEL1)) {
@@ -371,6 +373,7 @@ VL53L0X_Error VL53L0X_DataInit(VL53L0X_DEV Dev) {
   /* read WHO_AM_I */
 
   VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReadDataFromDeviceDone, 0);
+  PALDevDataSet(Dev, SingleRangingPrepared, 0);
 
 #ifdef USE_IQC_STATION
   if (Status == VL53L0X_ERROR_NONE)
@@ -528,6 +531,24 @@ VL53L0X_GetTuningSettingBuffer(VL53L0X_DEV Dev, uint8_t **ppTuningSettingBuffer,
 
 VL53L0X_Error VL53L0X_StaticInit(VL53L0X_DEV Dev) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_InitState_t State;
+
+  LOG_FUNCTION_START("");
+
+  State.Step = VL53L0X_INITSTEP_NVM;
+
+  do {
+    Status = VL53L0X_StaticInitStep(Dev, &State);
+  } while ((Status == VL53L0X_ERROR_NONE) &&
+           (State.Step != VL53L0X_INITSTEP_DONE));
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_StaticInitStep(VL53L0X_DEV Dev,
+                                     VL53L0X_InitState_t *pState) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   VL53L0X_DeviceParameters_t CurrentParameters;
   uint8_t *pTuningSettingBuffer;
   uint16_t tempword = 0;
@@ -542,127 +563,148 @@ VL53L0X_Error VL53L0X_StaticInit(VL53L0X_DEV Dev) {
 
   LOG_FUNCTION_START("");
 
-  Status = VL53L0X_get_info_from_device(Dev, 1);
-
-  /* set the ref spad from NVM */
-  count = (uint32_t)VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount);
-  ApertureSpads = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType);
+  switch (pState->Step) {
+  case VL53L0X_INITSTEP_NVM:
+    Status = VL53L0X_get_info_from_device(Dev, 1);
+    pState->TuningIndex = 0;
+    if (Status == VL53L0X_ERROR_NONE)
+      pState->Step = VL53L0X_INITSTEP_REF_SPADS;
+    break;
 
-  /* NVM value invalid */
-  if ((ApertureSpads > 1) || ((ApertureSpads == 1) && (count > 32)) ||
-      ((ApertureSpads == 0) && (count > 12)))
-    Status = VL53L0X_perform_ref_spad_management(Dev, &refSpadCount,
-                                                 &isApertureSpads);
-  else
-    Status = VL53L0X_set_reference_spads(Dev, count, ApertureSpads);
+  case VL53L0X_INITSTEP_REF_SPADS:
+    /* set the ref spad from NVM */
+    count =
+        (uint32_t)VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount);
+    ApertureSpads = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType);
+
+    /* NVM value invalid */
+    if ((ApertureSpads > 1) || ((ApertureSpads == 1) && (count > 32)) ||
+        ((ApertureSpads == 0) && (count > 12)))
+      Status = VL53L0X_perform_ref_spad_management(Dev, &refSpadCount,
+                                                   &isApertureSpads);
+    else
+      Status = VL53L0X_set_reference_spads(Dev, count, ApertureSpads);
 
-  /* Initialize tuning settings buffer to prevent compiler warning. */
-  pTuningSettingBuffer = DefaultTuningSettings;
+    if (Status == VL53L0X_ERROR_NONE)
+      pState->Step = VL53L0X_INITSTEP_TUNING;
+    break;
 
-  if (Status == VL53L0X_ERROR_NONE) {
+  case VL53L0X_INITSTEP_TUNING:
     UseInternalTuningSettings = PALDevDataGet(Dev, UseInternalTuningSettings);
 
     if (UseInternalTuningSettings == 0)
       pTuningSettingBuffer = PALDevDataGet(Dev, pTuningSettingsPointer);
     else
       pTuningSettingBuffer = DefaultTuningSettings;
-  }
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_load_tuning_settings(Dev, pTuningSettingBuffer);
+    Status = VL53L0X_load_tuning_settings_part(
+        Dev, pTuningSettingBuffer, &pState->TuningIndex,
+        VL53L0X_TUNING_WRITES_PER_STEP);
 
-  /* Set interrupt config to new sample ready */
-  if (Status == VL53L0X_ERROR_NONE) {
+    if ((Status == VL53L0X_ERROR_NONE) &&
+        (*(pTuningSettingBuffer + pState->TuningIndex) == 0))
+      pState->Step = VL53L0X_INITSTEP_PARAMETERS;
+    break;
+
+  case VL53L0X_INITSTEP_PARAMETERS:
+    /* Set interrupt config to new sample ready */
     Status = VL53L0X_SetGpioConfig(
         Dev, 0, 0, VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY,
         VL53L0X_INTERRUPTPOLARITY_LOW);
-  }
-
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-    Status |= VL53L0X_RdWord(Dev, 0x84, &tempword);
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
-  }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    VL53L0X_SETDEVICESPECIFICPARAMETER(
-        Dev, OscFrequencyMHz, VL53L0X_FIXPOINT412TOFIXPOINT1616(tempword));
-  }
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+      Status |= VL53L0X_RdWord(Dev, 0x84, &tempword);
+      Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
+    }
 
-  /* After static init, some device parameters may be changed,
-   * so update them */
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_GetDeviceParameters(Dev, &CurrentParameters);
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(
+          Dev, OscFrequencyMHz, VL53L0X_FIXPOINT412TOFIXPOINT1616(tempword));
+    }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_GetFractionEnable(Dev, &tempbyte);
+    /* After static init, some device parameters may be changed,
+     * so update them */
     if (Status == VL53L0X_ERROR_NONE)
-      PALDevDataSet(Dev, RangeFractionalEnable, tempbyte);
-  }
+      Status = VL53L0X_GetDeviceParameters(Dev, &CurrentParameters);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    PALDevDataSet(Dev, CurrentParameters, CurrentParameters);
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetFractionEnable(Dev, &tempbyte);
+      if (Status == VL53L0X_ERROR_NONE)
+        PALDevDataSet(Dev, RangeFractionalEnable, tempbyte);
+    }
 
-  /* read the sequence config and save it */
-  if (Status == VL53L0X_ERROR_NONE) {
+    if (Status == VL53L0X_ERROR_NONE) {
+      PALDevDataSet(Dev, CurrentParameters, CurrentParameters);
+      pState->Step = VL53L0X_INITSTEP_SEQUENCE;
+    }
+    break;
+
+  case VL53L0X_INITSTEP_SEQUENCE:
+    /* read the sequence config and save it */
     Status = VL53L0X_RdByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, &tempbyte);
     if (Status == VL53L0X_ERROR_NONE)
       PALDevDataSet(Dev, SequenceConfig, tempbyte);
-  }
 
-  /* Disable MSRC and TCC by default */
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_SetSequenceStepEnable(Dev, VL53L0X_SEQUENCESTEP_TCC, 0);
+    /* Disable MSRC and TCC by default */
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_SetSequenceStepEnable(Dev, VL53L0X_SEQUENCESTEP_TCC, 0);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_SetSequenceStepEnable(Dev, VL53L0X_SEQUENCESTEP_MSRC, 0);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_SetSequenceStepEnable(Dev, VL53L0X_SEQUENCESTEP_MSRC, 0);
 
-  /* Set PAL State to standby */
-  if (Status == VL53L0X_ERROR_NONE)
-    PALDevDataSet(Dev, PalState, VL53L0X_STATE_IDLE);
+    /* Set PAL State to standby */
+    if (Status == VL53L0X_ERROR_NONE)
+      PALDevDataSet(Dev, PalState, VL53L0X_STATE_IDLE);
 
-  /* Store pre-range vcsel period */
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_GetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_PRE_RANGE,
-                                         &vcselPulsePeriodPCLK);
-  }
+    /* Store pre-range vcsel period */
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_PRE_RANGE,
+                                           &vcselPulsePeriodPCLK);
+    }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod,
-                                       vcselPulsePeriodPCLK);
-  }
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod,
+                                         vcselPulsePeriodPCLK);
+    }
 
-  /* Store final-range vcsel period */
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_GetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE,
-                                         &vcselPulsePeriodPCLK);
-  }
+    /* Store final-range vcsel period */
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetVcselPulsePeriod(
+          Dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE, &vcselPulsePeriodPCLK);
+    }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod,
-                                       vcselPulsePeriodPCLK);
-  }
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod,
+                                         vcselPulsePeriodPCLK);
+    }
 
-  /* Store pre-range timeout */
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_GetSequenceStepTimeout(Dev, VL53L0X_SEQUENCESTEP_PRE_RANGE,
-                                            &seqTimeoutMilliSecs);
-  }
+    /* Store pre-range timeout */
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetSequenceStepTimeout(
+          Dev, VL53L0X_SEQUENCESTEP_PRE_RANGE, &seqTimeoutMilliSecs);
+    }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs,
-                                       seqTimeoutMilliSecs);
-  }
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs,
+                                         seqTimeoutMilliSecs);
+    }
 
-  /* Store final-range timeout */
-  if (Status == VL53L0X_ERROR_NONE) {
-    Status = VL53L0X_GetSequenceStepTimeout(
-        Dev, VL53L0X_SEQUENCESTEP_FINAL_RANGE, &seqTimeoutMilliSecs);
-  }
+    /* Store final-range timeout */
+    if (Status == VL53L0X_ERROR_NONE) {
+      Status = VL53L0X_GetSequenceStepTimeout(
+          Dev, VL53L0X_SEQUENCESTEP_FINAL_RANGE, &seqTimeoutMilliSecs);
+    }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs,
-                                       seqTimeoutMilliSecs);
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs,
+                                         seqTimeoutMilliSecs);
+      pState->Step = VL53L0X_INITSTEP_DONE;
+    }
+    break;
+
+  default: /* VL53L0X_INITSTEP_DONE */
+    break;
   }
 
   LOG_FUNCTION_END(Status);
@@ -826,6 +868,8 @@ VL53L0X_Error VL53L0X_SetDeviceMode(VL53L0X_DEV Dev,
 
   LOG_FUNCTION_START("%d", (int)DeviceMode);
 
+  PALDevDataSet(Dev, SingleRangingPrepared, 0);
+
   switch (DeviceMode) {
   case VL53L0X_DEVICEMODE_SINGLE_RANGING:
   case VL53L0X_DEVICEMODE_CONTINUOUS_RANGING:
@@ -1986,8 +2030,24 @@ VL53L0X_PerformXTalkCalibration(VL53L0X_DEV Dev,
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   LOG_FUNCTION_START("");
 
+  Status = VL53L0X_perform_xtalk_calibration(
+      Dev, XTalkCalDistance, NULL, pXTalkCompensationRateMegaCps, NULL);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_PerformXTalkCalibrationConverged(
+    VL53L0X_DEV Dev, FixPoint1616_t XTalkCalDistance,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    FixPoint1616_t *pXTalkCompensationRateMegaCps, uint16_t *pSamples) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
   Status = VL53L0X_perform_xtalk_calibration(Dev, XTalkCalDistance,
-                                             pXTalkCompensationRateMegaCps);
+                                             pConvergence,
+                                             pXTalkCompensationRateMegaCps,
+                                             pSamples);
 
   LOG_FUNCTION_END(Status);
   return Status;
@@ -2001,7 +2061,21 @@ VL53L0X_PerformOffsetCalibration(VL53L0X_DEV Dev,
   LOG_FUNCTION_START("");
 
   Status = VL53L0X_perform_offset_calibration(Dev, CalDistanceMilliMeter,
-                                              pOffsetMicroMeter);
+                                              NULL, pOffsetMicroMeter, NULL);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_PerformOffsetCalibrationConverged(
+    VL53L0X_DEV Dev, FixPoint1616_t CalDistanceMilliMeter,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    int32_t *pOffsetMicroMeter, uint16_t *pSamples) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
+  Status = VL53L0X_perform_offset_calibration(
+      Dev, CalDistanceMilliMeter, pConvergence, pOffsetMicroMeter, pSamples);
 
   LOG_FUNCTION_END(Status);
   return Status;
@@ -2042,55 +2116,52 @@ VL53L0X_Error VL53L0X_CheckAndLoadInterruptSettings(VL53L0X_DEV Dev,
   return Status;
 }
 
+static void batch_stop_variable(VL53L0X_DEV Dev, VL53L0X_RegBatch_t *pBatch) {
+  VL53L0X_batch_write(pBatch, 0x80, 0x01);
+  VL53L0X_batch_write(pBatch, 0xFF, 0x01);
+  VL53L0X_batch_write(pBatch, 0x00, 0x00);
+  VL53L0X_batch_write(pBatch, 0x91, PALDevDataGet(Dev, StopVariable));
+  VL53L0X_batch_write(pBatch, 0x00, 0x01);
+  VL53L0X_batch_write(pBatch, 0xFF, 0x00);
+  VL53L0X_batch_write(pBatch, 0x80, 0x00);
+}
+
 VL53L0X_Error VL53L0X_StartMeasurement(VL53L0X_DEV Dev) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   VL53L0X_DeviceModes DeviceMode;
-  uint8_t Byte;
-  uint8_t StartStopByte = VL53L0X_REG_SYSRANGE_MODE_START_STOP;
-  uint32_t LoopNb;
+  VL53L0X_RegBatch_t Batch;
   LOG_FUNCTION_START("");
 
   /* Get Current DeviceMode */
   VL53L0X_GetDeviceMode(Dev, &DeviceMode);
 
-  Status = VL53L0X_WrByte(Dev, 0x80, 0x01);
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-  Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-  Status = VL53L0X_WrByte(Dev, 0x91, PALDevDataGet(Dev, StopVariable));
-  Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
-  Status = VL53L0X_WrByte(Dev, 0x80, 0x00);
+  VL53L0X_batch_init(&Batch);
+  batch_stop_variable(Dev, &Batch);
 
   switch (DeviceMode) {
   case VL53L0X_DEVICEMODE_SINGLE_RANGING:
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START, 0x01);
+    VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSRANGE_START, 0x01);
 
-    Byte = StartStopByte;
-    if (Status == VL53L0X_ERROR_NONE) {
-      /* Wait until start bit has been cleared */
-      LoopNb = 0;
-      do {
-        if (LoopNb > 0)
-          Status = VL53L0X_RdByte(Dev, VL53L0X_REG_SYSRANGE_START, &Byte);
-        LoopNb = LoopNb + 1;
-      } while (((Byte & StartStopByte) == StartStopByte) &&
-               (Status == VL53L0X_ERROR_NONE) &&
-               (LoopNb < VL53L0X_DEFAULT_MAX_LOOP));
-
-      if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP)
-        Status = VL53L0X_ERROR_TIME_OUT;
-    }
+    /* Wait until start bit has been cleared */
+    VL53L0X_batch_poll(&Batch, VL53L0X_REG_SYSRANGE_START,
+                       VL53L0X_REG_SYSRANGE_MODE_START_STOP, 0x00);
+    Status = VL53L0X_batch_submit(Dev, &Batch);
 
+    /* The stop variable stays loaded for the following single ranges */
+    if (Status == VL53L0X_ERROR_NONE)
+      PALDevDataSet(Dev, SingleRangingPrepared, 1);
     break;
   case VL53L0X_DEVICEMODE_CONTINUOUS_RANGING:
     /* Back-to-back mode */
+    Status = VL53L0X_batch_submit(Dev, &Batch);
 
     /* Check if need to apply interrupt settings */
     if (Status == VL53L0X_ERROR_NONE)
       Status = VL53L0X_CheckAndLoadInterruptSettings(Dev, 1);
 
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
-                            VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
+                              VL53L0X_REG_SYSRANGE_MODE_BACKTOBACK);
     if (Status == VL53L0X_ERROR_NONE) {
       /* Set PAL State to Running */
       PALDevDataSet(Dev, PalState, VL53L0X_STATE_RUNNING);
@@ -2098,12 +2169,15 @@ VL53L0X_Error VL53L0X_StartMeasurement(VL53L0X_DEV Dev) {
     break;
   case VL53L0X_DEVICEMODE_CONTINUOUS_TIMED_RANGING:
     /* Continuous mode */
+    Status = VL53L0X_batch_submit(Dev, &Batch);
+
     /* Check if need to apply interrupt settings */
     if (Status == VL53L0X_ERROR_NONE)
       Status = VL53L0X_CheckAndLoadInterruptSettings(Dev, 1);
 
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
-                            VL53L0X_REG_SYSRANGE_MODE_TIMED);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
+                              VL53L0X_REG_SYSRANGE_MODE_TIMED);
 
     if (Status == VL53L0X_ERROR_NONE) {
       /* Set PAL State to Running */
@@ -2121,16 +2195,21 @@ VL53L0X_Error VL53L0X_StartMeasurement(VL53L0X_DEV Dev) {
 
 VL53L0X_Error VL53L0X_StopMeasurement(VL53L0X_DEV Dev) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
   LOG_FUNCTION_START("");
 
-  Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
-                          VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT);
+  VL53L0X_batch_init(&Batch);
+  VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSRANGE_START,
+                      VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x01);
+  VL53L0X_batch_write(&Batch, 0x00, 0x00);
+  VL53L0X_batch_write(&Batch, 0x91, 0x00);
+  VL53L0X_batch_write(&Batch, 0x00, 0x01);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x00);
+  Status = VL53L0X_batch_submit(Dev, &Batch);
 
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-  Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-  Status = VL53L0X_WrByte(Dev, 0x91, 0x00);
-  Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+  /* 0x91 was cleared, single ranges must be prepared again */
+  PALDevDataSet(Dev, SingleRangingPrepared, 0);
 
   if (Status == VL53L0X_ERROR_NONE) {
     /* Set PAL State to Idle */
@@ -2156,7 +2235,15 @@ VL53L0X_Error VL53L0X_GetMeasurementDataReady(VL53L0X_DEV Dev,
   InterruptConfig =
       VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality);
 
-  if (InterruptConfig == VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY) {
+  if (VL53L0X_gpio_data_ready_enabled(Dev)) {
+    /* The host pin follows the interrupt, no need to ask the device */
+    if (Dev->GpioLevelHook(Dev->GpioLevelContext) ==
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Pin0GpioPolarity))
+      *pMeasurementDataReady = 1;
+    else
+      *pMeasurementDataReady = 0;
+  } else if (InterruptConfig ==
+             VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY) {
     Status = VL53L0X_GetInterruptMaskStatus(Dev, &InterruptMask);
     if (InterruptMask == VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY)
       *pMeasurementDataReady = 1;
@@ -2192,139 +2279,18 @@ VL53L0X_Error VL53L0X_GetRangingMeasurementData(
     VL53L0X_DEV Dev,
     VL53L0X_RangingMeasurementData_t *pRangingMeasurementData) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-  uint8_t DeviceRangeStatus;
-  uint8_t RangeFractionalEnable;
-  uint8_t PalRangeStatus;
-  uint8_t XTalkCompensationEnable;
-  uint16_t AmbientRate;
-  FixPoint1616_t SignalRate;
-  uint16_t XTalkCompensationRateMegaCps;
-  uint16_t EffectiveSpadRtnCount;
-  uint16_t tmpuint16;
-  uint16_t XtalkRangeMilliMeter;
-  uint16_t LinearityCorrectiveGain;
-  uint8_t localBuffer[12];
-  VL53L0X_RangingMeasurementData_t LastRangeDataBuffer;
+  VL53L0X_RawResult_t RawResult;
 
   LOG_FUNCTION_START("");
 
-  /*
-   * use multi read even if some registers are not useful, result will
-   * be more efficient
-   * start reading at 0x14 dec20
-   * end reading at 0x21 dec33 total 14 bytes to read
-   */
-  Status = VL53L0X_ReadMulti(Dev, 0x14, localBuffer, 12);
-
-  if (Status == VL53L0X_ERROR_NONE) {
-
-    pRangingMeasurementData->ZoneId = 0;    /* Only one zone */
-    pRangingMeasurementData->TimeStamp = 0; /* Not Implemented */
-
-    tmpuint16 = VL53L0X_MAKEUINT16(localBuffer[11], localBuffer[10]);
-    /* cut1.1 if SYSTEM__RANGE_CONFIG if 1 range is 2bits fractional
-     *(format 11.2) else no fractional
-     */
-
-    pRangingMeasurementData->MeasurementTimeUsec = 0;
-
-    SignalRate = VL53L0X_FIXPOINT97TOFIXPOINT1616(
-        VL53L0X_MAKEUINT16(localBuffer[7], localBuffer[6]));
-    /* peak_signal_count_rate_rtn_mcps */
-    pRangingMeasurementData->SignalRateRtnMegaCps = SignalRate;
-
-    AmbientRate = VL53L0X_MAKEUINT16(localBuffer[9], localBuffer[8]);
-    pRangingMeasurementData->AmbientRateRtnMegaCps =
-        VL53L0X_FIXPOINT97TOFIXPOINT1616(AmbientRate);
-
-    EffectiveSpadRtnCount = VL53L0X_MAKEUINT16(localBuffer[3], localBuffer[2]);
-    /* EffectiveSpadRtnCount is 8.8 format */
-    pRangingMeasurementData->EffectiveSpadRtnCount = EffectiveSpadRtnCount;
-
-    DeviceRangeStatus = localBuffer[0];
-
-    /* Get Linearity Corrective Gain */
-    LinearityCorrectiveGain = PALDevDataGet(Dev, LinearityCorrectiveGain);
-
-    /* Get ranging configuration */
-    RangeFractionalEnable = PALDevDataGet(Dev, RangeFractionalEnable);
-
-    if (LinearityCorrectiveGain != 1000) {
-
-      tmpuint16 =
-          (uint16_t)((LinearityCorrectiveGain * tmpuint16 + 500) / 1000);
-
-      /* Implement Xtalk */
-      VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps,
-                                XTalkCompensationRateMegaCps);
-      VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationEnable,
-                                XTalkCompensationEnable);
-
-      if (XTalkCompensationEnable) {
-
-        if ((SignalRate -
-             ((XTalkCompensationRateMegaCps * EffectiveSpadRtnCount) >> 8)) <=
-            0) {
-          if (RangeFractionalEnable)
-            XtalkRangeMilliMeter = 8888;
-          else
-            XtalkRangeMilliMeter = 8888 << 2;
-        } else {
-          XtalkRangeMilliMeter =
-              (tmpuint16 * SignalRate) /
-              (SignalRate -
-               ((XTalkCompensationRateMegaCps * EffectiveSpadRtnCount) >> 8));
-        }
-
-        tmpuint16 = XtalkRangeMilliMeter;
-      }
-    }
-
-    if (RangeFractionalEnable) {
-      pRangingMeasurementData->RangeMilliMeter = (uint16_t)((tmpuint16) >> 2);
-      pRangingMeasurementData->RangeFractionalPart =
-          (uint8_t)((tmpuint16 & 0x03) << 6);
-    } else {
-      pRangingMeasurementData->RangeMilliMeter = tmpuint16;
-      pRangingMeasurementData->RangeFractionalPart = 0;
-    }
-
-    /*
-     * For a standard definition of RangeStatus, this should
-     * return 0 in case of good result after a ranging
-     * The range status depends on the device so call a device
-     * specific function to obtain the right Status.
-     */
-    Status |= VL53L0X_get_pal_range_status(
-        Dev, DeviceRangeStatus, SignalRate, EffectiveSpadRtnCount,
-        pRangingMeasurementData, &PalRangeStatus);
-
-    if (Status == VL53L0X_ERROR_NONE)
-      pRangingMeasurementData->RangeStatus = PalRangeStatus;
-  }
-
-  if (Status == VL53L0X_ERROR_NONE) {
-    /* Copy last read data into Dev buffer */
-    LastRangeDataBuffer = PALDevDataGet(Dev, LastRangeMeasure);
+  Status = VL53L0X_read_raw_result(Dev, &RawResult);
 
-    LastRangeDataBuffer.RangeMilliMeter =
-        pRangingMeasurementData->RangeMilliMeter;
-    LastRangeDataBuffer.RangeFractionalPart =
-        pRangingMeasurementData->RangeFractionalPart;
-    LastRangeDataBuffer.RangeDMaxMilliMeter =
-        pRangingMeasurementData->RangeDMaxMilliMeter;
-    LastRangeDataBuffer.MeasurementTimeUsec =
-        pRangingMeasurementData->MeasurementTimeUsec;
-    LastRangeDataBuffer.SignalRateRtnMegaCps =
-        pRangingMeasurementData->SignalRateRtnMegaCps;
-    LastRangeDataBuffer.AmbientRateRtnMegaCps =
-        pRangingMeasurementData->AmbientRateRtnMegaCps;
-    LastRangeDataBuffer.EffectiveSpadRtnCount =
-        pRangingMeasurementData->EffectiveSpadRtnCount;
-    LastRangeDataBuffer.RangeStatus = pRangingMeasurementData->RangeStatus;
+  if ((Status == VL53L0X_ERROR_NONE) && (Dev->RawResultHook != NULL))
+    Dev->RawResultHook(&RawResult, Dev->RawResultContext);
 
-    PALDevDataSet(Dev, LastRangeMeasure, LastRangeDataBuffer);
-  }
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_decode_ranging_result(Dev, &RawResult,
+                                           pRangingMeasurementData);
 
   LOG_FUNCTION_END(Status);
   return Status;
@@ -2376,6 +2342,104 @@ VL53L0X_Error VL53L0X_PerformSingleRangingMeasurement(
   return Status;
 }
 
+VL53L0X_Error VL53L0X_PrepareSingleRanging(VL53L0X_DEV Dev) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
+
+  LOG_FUNCTION_START("");
+
+  Status = VL53L0X_SetDeviceMode(Dev, VL53L0X_DEVICEMODE_SINGLE_RANGING);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    VL53L0X_batch_init(&Batch);
+    batch_stop_variable(Dev, &Batch);
+    Status = VL53L0X_batch_submit(Dev, &Batch);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE)
+    PALDevDataSet(Dev, SingleRangingPrepared, 1);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_PerformPreparedSingleRanging(
+    VL53L0X_DEV Dev,
+    VL53L0X_RangingMeasurementData_t *pRangingMeasurementData) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+  LOG_FUNCTION_START("");
+
+  if (!PALDevDataGet(Dev, SingleRangingPrepared))
+    Status = VL53L0X_PrepareSingleRanging(Dev);
+
+  /* The data ready wait covers the start bit clearing */
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
+                            VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT |
+                                VL53L0X_REG_SYSRANGE_MODE_START_STOP);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_measurement_poll_for_completion(Dev);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_GetRangingMeasurementData(Dev, pRangingMeasurementData);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_ClearInterruptMask(Dev, 0);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_GetMeasurementDataAndRearm(
+    VL53L0X_DEV Dev, VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+    uint8_t CheckInterruptClear) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_DeviceModes DeviceMode;
+  VL53L0X_RawResult_t RawResult;
+  uint8_t StartMode = 0;
+  uint8_t Byte = 0;
+
+  LOG_FUNCTION_START("");
+
+  VL53L0X_GetDeviceMode(Dev, &DeviceMode);
+
+  /* Continuous modes rearm themselves, single ranging is started again */
+  if (DeviceMode == VL53L0X_DEVICEMODE_SINGLE_RANGING) {
+    if (!PALDevDataGet(Dev, SingleRangingPrepared))
+      Status = VL53L0X_PrepareSingleRanging(Dev);
+    StartMode = VL53L0X_REG_SYSRANGE_MODE_SINGLESHOT |
+                VL53L0X_REG_SYSRANGE_MODE_START_STOP;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    if (CheckInterruptClear) {
+      /* Only start the next range once the interrupt is known clear */
+      Status = VL53L0X_consume_raw_result(Dev, &RawResult, 1, 0, &Byte);
+
+      if ((Status == VL53L0X_ERROR_NONE) && ((Byte & 0x07) != 0x00))
+        Status = VL53L0X_ClearInterruptMask(Dev, 0);
+
+      if ((Status == VL53L0X_ERROR_NONE) && (StartMode != 0))
+        Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START, StartMode);
+    } else {
+      Status = VL53L0X_consume_raw_result(Dev, &RawResult, 1, StartMode, NULL);
+    }
+  }
+
+  /* Decoding overlaps the next range */
+  if ((Status == VL53L0X_ERROR_NONE) && (Dev->RawResultHook != NULL))
+    Dev->RawResultHook(&RawResult, Dev->RawResultContext);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_decode_ranging_result(Dev, &RawResult,
+                                           pRangingMeasurementData);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_SetNumberOfROIZones(VL53L0X_DEV Dev,
                                           uint8_t NumberOfROIZones) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
@@ -2495,9 +2559,11 @@ VL53L0X_Error VL53L0X_SetGpioConfig(VL53L0X_DEV Dev, uint8_t Pin,
                                   0xEF, data);
     }
 
-    if (Status == VL53L0X_ERROR_NONE)
+    if (Status == VL53L0X_ERROR_NONE) {
       VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality,
                                          Functionality);
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, Pin0GpioPolarity, Polarity);
+    }
 
     if (Status == VL53L0X_ERROR_NONE)
       Status = VL53L0X_ClearInterruptMask(Dev, 0);
@@ -2566,6 +2632,7 @@ VL53L0X_Error VL53L0X_GetGpioConfig(VL53L0X_DEV Dev, uint8_t Pin,
     *pFunctionality = GpioFunctionality;
     VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality,
                                        GpioFunctionality);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, Pin0GpioPolarity, *pPolarity);
   }
 
   LOG_FUNCTION_END(Status);
@@ -2622,27 +2689,22 @@ VL53L0X_Error VL53L0X_GetInterruptThresholds(VL53L0X_DEV Dev,
 VL53L0X_Error VL53L0X_GetStopCompletedStatus(VL53L0X_DEV Dev,
                                              uint32_t *pStopStatus) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
   uint8_t Byte = 0;
   LOG_FUNCTION_START("");
 
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_RdByte(Dev, 0x04, &Byte);
-
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x0);
+  VL53L0X_batch_init(&Batch);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x01);
+  VL53L0X_batch_read(&Batch, 0x04, &Byte, 1);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x00);
+  Status = VL53L0X_batch_submit(Dev, &Batch);
 
   *pStopStatus = Byte;
 
-  if (Byte == 0) {
-    Status = VL53L0X_WrByte(Dev, 0x80, 0x01);
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-    Status = VL53L0X_WrByte(Dev, 0x00, 0x00);
-    Status = VL53L0X_WrByte(Dev, 0x91, PALDevDataGet(Dev, StopVariable));
-    Status = VL53L0X_WrByte(Dev, 0x00, 0x01);
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
-    Status = VL53L0X_WrByte(Dev, 0x80, 0x00);
+  if ((Status == VL53L0X_ERROR_NONE) && (Byte == 0)) {
+    VL53L0X_batch_init(&Batch);
+    batch_stop_variable(Dev, &Batch);
+    Status = VL53L0X_batch_submit(Dev, &Batch);
   }
 
   LOG_FUNCTION_END(Status);
@@ -2653,16 +2715,20 @@ VL53L0X_Error VL53L0X_GetStopCompletedStatus(VL53L0X_DEV Dev,
 VL53L0X_Error VL53L0X_ClearInterruptMask(VL53L0X_DEV Dev,
                                          uint32_t InterruptMask) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
   uint8_t LoopCount;
-  uint8_t Byte;
+  uint8_t Byte = 0;
   LOG_FUNCTION_START("");
 
   /* clear bit 0 range interrupt, bit 1 error interrupt */
+  VL53L0X_batch_init(&Batch);
+  VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x01);
+  VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x00);
+  VL53L0X_batch_read(&Batch, VL53L0X_REG_RESULT_INTERRUPT_STATUS, &Byte, 1);
+
   LoopCount = 0;
   do {
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x01);
-    Status |= VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x00);
-    Status |= VL53L0X_RdByte(Dev, VL53L0X_REG_RESULT_INTERRUPT_STATUS, &Byte);
+    Status = VL53L0X_batch_submit(Dev, &Batch);
     LoopCount++;
   } while (((Byte & 0x07) != 0x00) && (LoopCount < 3) &&
            (Status == VL53L0X_ERROR_NONE));
@@ -2796,6 +2862,35 @@ VL53L0X_Error VL53L0X_GetReferenceSpads(VL53L0X_DEV Dev, uint32_t *pSpadCount,
   return Status;
 }
 
+VL53L0X_Error VL53L0X_SetVerifyPolicy(VL53L0X_DEV Dev,
+                                      VL53L0X_VerifyPolicy Policy) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
+  if (Policy > VL53L0X_VERIFY_NEVER) {
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+  } else {
+    PALDevDataSet(Dev, VerifyPolicy, Policy);
+    PALDevDataSet(Dev, VerifyDone, 0);
+  }
+
+  LOG_FUNCTION_END(Status);
+
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_GetVerifyFailCount(VL53L0X_DEV Dev,
+                                         uint16_t *pFailCount) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
+  *pFailCount = PALDevDataGet(Dev, VerifyFailCount);
+
+  LOG_FUNCTION_END(Status);
+
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_PerformRefSpadManagement(VL53L0X_DEV Dev,
                                                uint32_t *refSpadCount,
                                                uint8_t *isApertureSpads) {
@@ -48,16 +48,177 @@
 uint32_t refArrayQuadrants[4] = {REF_ARRAY_SPAD_10, REF_ARRAY_SPAD_5,
                                  REF_ARRAY_SPAD_0, REF_ARRAY_SPAD_5};
 
+/** @brief Running sums of the ranges a calibration averages */
+typedef struct {
+  uint32_t SumRanging;       /*!< Sum of the ranges, mm */
+  uint64_t SumSignalRate;    /*!< Sum of the return signal rates, 16.16 */
+  uint32_t SumSpads;         /*!< Sum of the return SPAD counts */
+  uint32_t ValidCount;       /*!< Number of valid ranges summed */
+  int32_t FirstResult;       /*!< Result of the first valid range alone */
+  int64_t SumDiff;           /*!< Sum of the results less FirstResult */
+  uint64_t SumDiffSquared;   /*!< Sum of their squares */
+} VL53L0X_CalibrationSums_t;
+
+static const VL53L0X_CalibrationConvergence_t DefaultConvergence = {50, 50,
+                                                                     0};
+
+static uint8_t calibration_converged(VL53L0X_CalibrationSums_t *pSums,
+                                     uint32_t Tolerance) {
+  int64_t n = pSums->ValidCount;
+  int64_t m2;
+
+  /*
+   * Sum of the squared deviations from the mean, from sums shifted by the
+   * first result so they stay small. The 95% confidence interval of the
+   * mean is within +/- 2 * sqrt(m2 / (n - 1) / n).
+   */
+  m2 = (int64_t)pSums->SumDiffSquared - pSums->SumDiff * (pSums->SumDiff / n);
+  if (m2 < 0)
+    m2 = 0;
+
+  return ((uint64_t)(m2 / n / (n - 1)) <=
+          (uint64_t)Tolerance * Tolerance / 4);
+}
+
+static VL53L0X_Error
+calibration_sample(VL53L0X_DEV Dev,
+                   const VL53L0X_CalibrationConvergence_t *pConvergence,
+                   uint32_t XTalkCalDistanceAsInt,
+                   VL53L0X_CalibrationSums_t *pSums, uint16_t *pSamples) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_Error StopStatus = VL53L0X_ERROR_NONE;
+  VL53L0X_RangingMeasurementData_t RangingMeasurementData;
+  VL53L0X_DeviceModes DeviceMode;
+  uint32_t StopCompleted = 0;
+  uint32_t LoopNb = 0;
+  uint32_t Tolerance;
+  uint32_t spads;
+  uint32_t signalPerSpad;
+  int32_t rangeRatio;
+  int32_t result;
+  int32_t diff;
+  uint16_t meas = 0;
+  uint8_t started = 0;
+
+  /*
+   * Each valid range gives a result of its own, the offset in quarter mm
+   * or the xtalk rate in 16.16 MCPS. Their scatter tells when the average
+   * is known well enough, the tolerance is converted to the same unit.
+   */
+  Tolerance = pConvergence->Tolerance;
+  if (XTalkCalDistanceAsInt == 0)
+    Tolerance = (Tolerance + 0x2000) >> 14;
+  if ((Tolerance == 0) && (pConvergence->Tolerance > 0))
+    Tolerance = 1;
+
+  memset(pSums, 0, sizeof(VL53L0X_CalibrationSums_t));
+
+  /* Back to back ranging, the device does not wait for the host between
+   * ranges */
+  Status = VL53L0X_GetDeviceMode(Dev, &DeviceMode);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_SetDeviceMode(Dev, VL53L0X_DEVICEMODE_CONTINUOUS_RANGING);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status = VL53L0X_StartMeasurement(Dev);
+    started = (Status == VL53L0X_ERROR_NONE);
+  }
+
+  while ((Status == VL53L0X_ERROR_NONE) && (meas < pConvergence->MaxSamples)) {
+    Status = VL53L0X_measurement_poll_for_completion(Dev);
+
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_GetRangingMeasurementData(Dev, &RangingMeasurementData);
+
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_ClearInterruptMask(Dev, 0);
+
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
+
+    meas++;
+
+    /* The range is valid when RangeStatus = 0 */
+    if (RangingMeasurementData.RangeStatus != 0)
+      continue;
+
+    spads = RangingMeasurementData.EffectiveSpadRtnCount / 256;
+    pSums->SumRanging += RangingMeasurementData.RangeMilliMeter;
+    pSums->SumSignalRate += RangingMeasurementData.SignalRateRtnMegaCps;
+    pSums->SumSpads += spads;
+    pSums->ValidCount++;
+
+    if (XTalkCalDistanceAsInt == 0) {
+      result = (int32_t)RangingMeasurementData.RangeMilliMeter << 2;
+    } else {
+      /* Same as the xtalk rate of VL53L0X_perform_xtalk_calibration, not
+       * clamped at 0 so the scatter is not hidden */
+      signalPerSpad = RangingMeasurementData.SignalRateRtnMegaCps /
+                      ((spads > 0) ? spads : 1);
+      rangeRatio =
+          ((uint32_t)RangingMeasurementData.RangeMilliMeter << 16) /
+          XTalkCalDistanceAsInt;
+      result = (int32_t)(((int64_t)signalPerSpad * ((1 << 16) - rangeRatio) +
+                          0x8000) >>
+                         16);
+    }
+
+    if (pSums->ValidCount == 1)
+      pSums->FirstResult = result;
+    diff = result - pSums->FirstResult;
+    pSums->SumDiff += diff;
+    pSums->SumDiffSquared += (uint64_t)((int64_t)diff * diff);
+
+    if ((Tolerance > 0) && (pSums->ValidCount >= 2) &&
+        (pSums->ValidCount >= pConvergence->MinSamples) &&
+        calibration_converged(pSums, Tolerance))
+      break;
+  }
+
+  /* Stop in any case, but report the first error */
+  if (started)
+    StopStatus = VL53L0X_StopMeasurement(Dev);
+
+  while (started && (StopStatus == VL53L0X_ERROR_NONE)) {
+    StopStatus = VL53L0X_GetStopCompletedStatus(Dev, &StopCompleted);
+    if ((StopStatus != VL53L0X_ERROR_NONE) || (StopCompleted == 0x00))
+      break;
+
+    LoopNb++;
+    if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP) {
+      StopStatus = VL53L0X_ERROR_TIME_OUT;
+      break;
+    }
+
+    VL53L0X_PollingDelay(Dev);
+  }
+
+  if (started && (StopStatus == VL53L0X_ERROR_NONE))
+    StopStatus = VL53L0X_ClearInterruptMask(Dev, 0);
+
+  if (started && (StopStatus == VL53L0X_ERROR_NONE))
+    StopStatus = VL53L0X_SetDeviceMode(Dev, DeviceMode);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = StopStatus;
+
+  if (pSamples != NULL)
+    *pSamples = meas;
+
+  /* no valid values found */
+  if ((Status == VL53L0X_ERROR_NONE) && (pSums->ValidCount == 0))
+    Status = VL53L0X_ERROR_RANGE_ERROR;
+
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_perform_xtalk_calibration(
     VL53L0X_DEV Dev, FixPoint1616_t XTalkCalDistance,
-    FixPoint1616_t *pXTalkCompensationRateMegaCps) {
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    FixPoint1616_t *pXTalkCompensationRateMegaCps, uint16_t *pSamples) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-  uint16_t sum_ranging = 0;
-  uint16_t sum_spads = 0;
-  FixPoint1616_t sum_signalRate = 0;
-  FixPoint1616_t total_count = 0;
-  uint8_t xtalk_meas = 0;
-  VL53L0X_RangingMeasurementData_t RangingMeasurementData;
+  VL53L0X_CalibrationSums_t Sums;
   FixPoint1616_t xTalkStoredMeanSignalRate;
   FixPoint1616_t xTalkStoredMeanRange;
   FixPoint1616_t xTalkStoredMeanRtnSpads;
@@ -66,9 +227,17 @@ VL53L0X_Error VL53L0X_perform_xtalk_calibration(
   uint32_t xTalkCalDistanceAsInt;
   FixPoint1616_t XTalkCompensationRateMegaCps;
 
+  if (pConvergence == NULL)
+    pConvergence = &DefaultConvergence;
+
   if (XTalkCalDistance <= 0)
     Status = VL53L0X_ERROR_INVALID_PARAMS;
 
+  /* Round Cal Distance to Whole Number.
+   * Note that the cal distance is in mm, therefore no resolution
+   * is lost.*/
+  xTalkCalDistanceAsInt = (XTalkCalDistance + 0x8000) >> 16;
+
   /* Disable the XTalk compensation */
   if (Status == VL53L0X_ERROR_NONE)
     Status = VL53L0X_SetXTalkCompensationEnable(Dev, 0);
@@ -79,42 +248,21 @@ VL53L0X_Error VL53L0X_perform_xtalk_calibration(
         Dev, VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD, 0);
   }
 
-  /* Perform 50 measurements and compute the averages */
-  if (Status == VL53L0X_ERROR_NONE) {
-    sum_ranging = 0;
-    sum_spads = 0;
-    sum_signalRate = 0;
-    total_count = 0;
-    for (xtalk_meas = 0; xtalk_meas < 50; xtalk_meas++) {
-      Status =
-          VL53L0X_PerformSingleRangingMeasurement(Dev, &RangingMeasurementData);
-
-      if (Status != VL53L0X_ERROR_NONE)
-        break;
-
-      /* The range is valid when RangeStatus = 0 */
-      if (RangingMeasurementData.RangeStatus == 0) {
-        sum_ranging = sum_ranging + RangingMeasurementData.RangeMilliMeter;
-        sum_signalRate =
-            sum_signalRate + RangingMeasurementData.SignalRateRtnMegaCps;
-        sum_spads =
-            sum_spads + RangingMeasurementData.EffectiveSpadRtnCount / 256;
-        total_count = total_count + 1;
-      }
-    }
-
-    /* no valid values found */
-    if (total_count == 0)
-      Status = VL53L0X_ERROR_RANGE_ERROR;
-  }
+  /* Average ranges until the xtalk rate is known well enough */
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = calibration_sample(
+        Dev, pConvergence,
+        (xTalkCalDistanceAsInt > 0) ? xTalkCalDistanceAsInt : 1, &Sums,
+        pSamples);
 
   if (Status == VL53L0X_ERROR_NONE) {
     /* FixPoint1616_t / uint16_t = FixPoint1616_t */
-    xTalkStoredMeanSignalRate = sum_signalRate / total_count;
+    xTalkStoredMeanSignalRate =
+        (FixPoint1616_t)(Sums.SumSignalRate / Sums.ValidCount);
     xTalkStoredMeanRange =
-        (FixPoint1616_t)((uint32_t)(sum_ranging << 16) / total_count);
+        (FixPoint1616_t)(((uint64_t)Sums.SumRanging << 16) / Sums.ValidCount);
     xTalkStoredMeanRtnSpads =
-        (FixPoint1616_t)((uint32_t)(sum_spads << 16) / total_count);
+        (FixPoint1616_t)(((uint64_t)Sums.SumSpads << 16) / Sums.ValidCount);
 
     /* Round Mean Spads to Whole Number.
      * Typically the calculated mean SPAD count is a whole number
@@ -129,20 +277,10 @@ VL53L0X_Error VL53L0X_perform_xtalk_calibration(
      */
     xTalkStoredMeanRtnSpadsAsInt = (xTalkStoredMeanRtnSpads + 0x8000) >> 16;
 
-    /* Round Cal Distance to Whole Number.
-     * Note that the cal distance is in mm, therefore no resolution
-     * is lost.*/
-    xTalkCalDistanceAsInt = (XTalkCalDistance + 0x8000) >> 16;
-
     if (xTalkStoredMeanRtnSpadsAsInt == 0 || xTalkCalDistanceAsInt == 0 ||
         xTalkStoredMeanRange >= XTalkCalDistance) {
       XTalkCompensationRateMegaCps = 0;
     } else {
-      /* Round Cal Distance to Whole Number.
-         Note that the cal distance is in mm, therefore no
-         resolution is lost.*/
-      xTalkCalDistanceAsInt = (XTalkCalDistance + 0x8000) >> 16;
-
       /* Apply division by mean spad count early in the
        * calculation to keep the numbers small.
        * This ensures we can maintain a 32bit calculation.
@@ -177,19 +315,19 @@ VL53L0X_Error VL53L0X_perform_xtalk_calibration(
   return Status;
 }
 
-VL53L0X_Error
-VL53L0X_perform_offset_calibration(VL53L0X_DEV Dev,
-                                   FixPoint1616_t CalDistanceMilliMeter,
-                                   int32_t *pOffsetMicroMeter) {
+VL53L0X_Error VL53L0X_perform_offset_calibration(
+    VL53L0X_DEV Dev, FixPoint1616_t CalDistanceMilliMeter,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    int32_t *pOffsetMicroMeter, uint16_t *pSamples) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-  uint16_t sum_ranging = 0;
-  FixPoint1616_t total_count = 0;
-  VL53L0X_RangingMeasurementData_t RangingMeasurementData;
+  VL53L0X_CalibrationSums_t Sums;
   FixPoint1616_t StoredMeanRange;
   uint32_t StoredMeanRangeAsInt;
   uint32_t CalDistanceAsInt_mm;
   uint8_t SequenceStepEnabled;
-  int meas = 0;
+
+  if (pConvergence == NULL)
+    pConvergence = &DefaultConvergence;
 
   if (CalDistanceMilliMeter <= 0)
     Status = VL53L0X_ERROR_INVALID_PARAMS;
@@ -211,33 +349,14 @@ VL53L0X_perform_offset_calibration(VL53L0X_DEV Dev,
     Status = VL53L0X_SetLimitCheckEnable(
         Dev, VL53L0X_CHECKENABLE_RANGE_IGNORE_THRESHOLD, 0);
 
-  /* Perform 50 measurements and compute the averages */
-  if (Status == VL53L0X_ERROR_NONE) {
-    sum_ranging = 0;
-    total_count = 0;
-    for (meas = 0; meas < 50; meas++) {
-      Status =
-          VL53L0X_PerformSingleRangingMeasurement(Dev, &RangingMeasurementData);
-
-      if (Status != VL53L0X_ERROR_NONE)
-        break;
-
-      /* The range is valid when RangeStatus = 0 */
-      if (RangingMeasurementData.RangeStatus == 0) {
-        sum_ranging = sum_ranging + RangingMeasurementData.RangeMilliMeter;
-        total_count = total_count + 1;
-      }
-    }
-
-    /* no valid values found */
-    if (total_count == 0)
-      Status = VL53L0X_ERROR_RANGE_ERROR;
-  }
+  /* Average ranges until the offset is known well enough */
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = calibration_sample(Dev, pConvergence, 0, &Sums, pSamples);
 
   if (Status == VL53L0X_ERROR_NONE) {
     /* FixPoint1616_t / uint16_t = FixPoint1616_t */
     StoredMeanRange =
-        (FixPoint1616_t)((uint32_t)(sum_ranging << 16) / total_count);
+        (FixPoint1616_t)(((uint64_t)Sums.SumRanging << 16) / Sums.ValidCount);
 
     StoredMeanRangeAsInt = (StoredMeanRange + 0x8000) >> 16;
 
@@ -510,6 +629,27 @@ VL53L0X_Error get_ref_spad_map(VL53L0X_DEV Dev, uint8_t *refSpadArray) {
   return status;
 }
 
+static uint8_t verify_needed(VL53L0X_DEV Dev) {
+  switch (PALDevDataGet(Dev, VerifyPolicy)) {
+  case VL53L0X_VERIFY_NEVER:
+    return 0;
+  case VL53L0X_VERIFY_FIRST:
+    return !PALDevDataGet(Dev, VerifyDone);
+  default:
+    return 1;
+  }
+}
+
+static void verify_done(VL53L0X_DEV Dev, uint8_t match) {
+  uint16_t failCount = PALDevDataGet(Dev, VerifyFailCount);
+
+  if (match) {
+    PALDevDataSet(Dev, VerifyDone, 1);
+  } else if (failCount < 0xFFFF) {
+    PALDevDataSet(Dev, VerifyFailCount, failCount + 1);
+  }
+}
+
 VL53L0X_Error enable_ref_spads(VL53L0X_DEV Dev, uint8_t apertureSpads,
                                uint8_t goodSpadArray[], uint8_t spadArray[],
                                uint32_t size, uint32_t start, uint32_t offset,
@@ -557,293 +697,641 @@ VL53L0X_Error enable_ref_spads(VL53L0X_DEV Dev, uint8_t apertureSpads,
   if (status == VL53L0X_ERROR_NONE)
     status = set_ref_spad_map(Dev, spadArray);
 
-  if (status == VL53L0X_ERROR_NONE) {
+  if ((status == VL53L0X_ERROR_NONE) && verify_needed(Dev)) {
     status = get_ref_spad_map(Dev, checkSpadArray);
 
     i = 0;
 
     /* Compare spad maps. If not equal report error. */
-    while (i < size) {
+    while ((status == VL53L0X_ERROR_NONE) && (i < size)) {
       if (spadArray[i] != checkSpadArray[i]) {
         status = VL53L0X_ERROR_REF_SPAD_INIT;
         break;
       }
       i++;
     }
+
+    verify_done(Dev, status == VL53L0X_ERROR_NONE);
   }
   return status;
 }
 
-VL53L0X_Error perform_ref_signal_measurement(VL53L0X_DEV Dev,
-                                             uint16_t *refSignalRate) {
+static VL53L0X_Error
+start_ref_signal_measurement(VL53L0X_DEV Dev,
+                             VL53L0X_CalibrationState_t *pState) {
   VL53L0X_Error status = VL53L0X_ERROR_NONE;
-  VL53L0X_RangingMeasurementData_t rangingMeasurementData;
-
-  uint8_t SequenceConfig = 0;
 
   /* store the value of the sequence config,
-   * this will be reset before the end of the function
+   * this will be reset by finish_ref_signal_measurement
    */
-
-  SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
+  pState->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
 
   /*
-   * This function performs a reference signal rate measurement.
+   * This function starts a reference signal rate measurement, the
+   * result is collected by finish_ref_signal_measurement once the
+   * device reports data ready.
    */
+  status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0xC0);
+
   if (status == VL53L0X_ERROR_NONE)
-    status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0xC0);
+    status = VL53L0X_SetDeviceMode(Dev, VL53L0X_DEVICEMODE_SINGLE_RANGING);
 
   if (status == VL53L0X_ERROR_NONE)
-    status =
-        VL53L0X_PerformSingleRangingMeasurement(Dev, &rangingMeasurementData);
+    status = VL53L0X_StartMeasurement(Dev);
+
+  return status;
+}
+
+static VL53L0X_Error
+finish_ref_signal_measurement(VL53L0X_DEV Dev,
+                              VL53L0X_CalibrationState_t *pState) {
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+  VL53L0X_RangingMeasurementData_t rangingMeasurementData;
+
+  PALDevDataSet(Dev, PalState, VL53L0X_STATE_IDLE);
+
+  status = VL53L0X_GetRangingMeasurementData(Dev, &rangingMeasurementData);
+
+  if (status == VL53L0X_ERROR_NONE)
+    status = VL53L0X_ClearInterruptMask(Dev, 0);
 
   if (status == VL53L0X_ERROR_NONE)
     status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
 
   if (status == VL53L0X_ERROR_NONE)
     status = VL53L0X_RdWord(Dev, VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF,
-                            refSignalRate);
+                            &pState->PeakSignalRateRef);
 
   if (status == VL53L0X_ERROR_NONE)
     status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
 
   if (status == VL53L0X_ERROR_NONE) {
     /* restore the previous Sequence Config */
-    status =
-        VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, SequenceConfig);
+    status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG,
+                            pState->SequenceConfig);
     if (status == VL53L0X_ERROR_NONE)
-      PALDevDataSet(Dev, SequenceConfig, SequenceConfig);
+      PALDevDataSet(Dev, SequenceConfig, pState->SequenceConfig);
   }
 
   return status;
 }
 
-VL53L0X_Error VL53L0X_perform_ref_spad_management(VL53L0X_DEV Dev,
-                                                  uint32_t *refSpadCount,
-                                                  uint8_t *isApertureSpads) {
+static VL53L0X_Error calibration_poll(VL53L0X_DEV Dev,
+                                      VL53L0X_CalibrationState_t *pState,
+                                      uint8_t *pReady) {
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+
+  /*
+   * Non blocking equivalent of VL53L0X_measurement_poll_for_completion,
+   * the number of unsuccessful polls is kept in the state.
+   */
+  *pReady = 0;
+  status = VL53L0X_GetMeasurementDataReady(Dev, pReady);
+
+  if (status == VL53L0X_ERROR_NONE) {
+    if (*pReady == 1) {
+      pState->PollCount = 0;
+    } else {
+      pState->PollCount++;
+      if (pState->PollCount >= VL53L0X_DEFAULT_MAX_LOOP)
+        status = VL53L0X_ERROR_TIME_OUT;
+      else
+        VL53L0X_PollingDelay(Dev);
+    }
+  }
+
+  return status;
+}
+
+static VL53L0X_Error add_next_ref_spad(VL53L0X_DEV Dev,
+                                       VL53L0X_CalibrationState_t *pState) {
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+  uint8_t startSelect = 0xB4;
+  uint32_t spadArraySize = 6;
+  int32_t nextGoodSpad = 0;
+
+  get_next_good_spad(Dev->Data.SpadData.RefGoodSpadMap, spadArraySize,
+                     pState->CurrentSpadIndex, &nextGoodSpad);
+
+  if (nextGoodSpad == -1)
+    return VL53L0X_ERROR_REF_SPAD_INIT;
+
+  (pState->RefSpadCount)++;
+
+  /* Cannot combine Aperture and Non-Aperture spads, so
+   * ensure the current spad is of the correct type.
+   */
+  if (is_aperture((uint32_t)startSelect + nextGoodSpad) !=
+      pState->NeedAptSpads)
+    return VL53L0X_ERROR_REF_SPAD_INIT;
+
+  pState->CurrentSpadIndex = nextGoodSpad;
+  status = enable_spad_bit(Dev->Data.SpadData.RefSpadEnables, spadArraySize,
+                           pState->CurrentSpadIndex);
+
+  if (status == VL53L0X_ERROR_NONE) {
+    pState->CurrentSpadIndex++;
+    /* Proceed to apply the additional spad and
+     * perform measurement. */
+    status = set_ref_spad_map(Dev, Dev->Data.SpadData.RefSpadEnables);
+  }
+
+  if (status == VL53L0X_ERROR_NONE) {
+    status = start_ref_signal_measurement(Dev, pState);
+    pState->Step = VL53L0X_CALSTEP_SPAD_ADD;
+  }
+
+  return status;
+}
+
+static uint32_t append_good_spads(uint8_t goodSpadArray[], uint8_t spadArray[],
+                                  uint32_t size, uint32_t start,
+                                  uint8_t apertureSpads, uint32_t offset,
+                                  uint32_t spadCount, uint32_t *lastSpad) {
+  uint32_t count = 0;
+  uint32_t currentSpad = offset;
+  int32_t nextGoodSpad = 0;
+
+  /*
+   * Same selection as enable_ref_spads, without the I2C. Stops short
+   * instead of failing when the good spads of the requested type run out,
+   * and returns the number of spads actually enabled.
+   */
+  while (count < spadCount) {
+    get_next_good_spad(goodSpadArray, size, currentSpad, &nextGoodSpad);
+
+    if ((nextGoodSpad == -1) ||
+        (is_aperture(start + nextGoodSpad) != apertureSpads))
+      break;
+
+    currentSpad = (uint32_t)nextGoodSpad;
+    enable_spad_bit(spadArray, size, currentSpad);
+    currentSpad++;
+    count++;
+  }
+  *lastSpad = currentSpad;
+
+  return count;
+}
+
+static VL53L0X_Error start_ref_spad_probe(VL53L0X_DEV Dev,
+                                          VL53L0X_CalibrationState_t *pState) {
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+  uint8_t startSelect = 0xB4;
+  uint32_t spadArraySize = 6;
+  uint16_t targetRefRate = PALDevDataGet(Dev, targetRefRate);
+  uint32_t step = 1;
+  uint32_t lastSpad = 0;
+
+  /*
+   * LastSpadArray stays at or below the target rate and adding SearchHigh
+   * spads to it exceeds it. The first measurement goes where the average
+   * rate per spad so far says the target is crossed. When it overshoots,
+   * the count just below is the likely answer and is measured next,
+   * otherwise the step doubles from the estimate until the target is
+   * exceeded. Once bracketed, the bracket is halved.
+   */
+  if (pState->SearchHigh > 0) {
+    if (pState->SearchProbes == 1)
+      step = pState->SearchHigh - 1;
+    else
+      step = pState->SearchHigh / 2;
+  } else if (pState->SearchProbes == 0) {
+    if (pState->PeakSignalRateRef > 0)
+      step = (uint32_t)(targetRefRate - pState->PeakSignalRateRef) *
+                 pState->RefSpadCount / pState->PeakSignalRateRef +
+             1;
+  } else {
+    step = 2 * pState->SearchStep;
+  }
+
+  memcpy(Dev->Data.SpadData.RefSpadEnables, pState->LastSpadArray,
+         spadArraySize);
+  step = append_good_spads(Dev->Data.SpadData.RefGoodSpadMap,
+                           Dev->Data.SpadData.RefSpadEnables, spadArraySize,
+                           startSelect, pState->NeedAptSpads,
+                           pState->CurrentSpadIndex, step, &lastSpad);
+
+  /* Out of spads of this type without reaching the target */
+  if (step == 0)
+    return VL53L0X_ERROR_REF_SPAD_INIT;
+
+  pState->SearchStep = step;
+  pState->SearchProbes++;
+
+  status = set_ref_spad_map(Dev, Dev->Data.SpadData.RefSpadEnables);
+
+  if (status == VL53L0X_ERROR_NONE) {
+    status = start_ref_signal_measurement(Dev, pState);
+    pState->Step = VL53L0X_CALSTEP_SPAD_SEARCH;
+  }
+
+  return status;
+}
+
+static void store_ref_spad_result(VL53L0X_DEV Dev,
+                                  VL53L0X_CalibrationState_t *pState) {
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, RefSpadsInitialised, 1);
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount,
+                                     (uint8_t)pState->RefSpadCount);
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType,
+                                     pState->IsApertureSpads);
+  pState->Step = VL53L0X_CALSTEP_DONE;
+}
+
+static VL53L0X_Error end_ref_spad_search(VL53L0X_DEV Dev,
+                                         VL53L0X_CalibrationState_t *pState) {
+  VL53L0X_Error status = VL53L0X_ERROR_NONE;
+  uint16_t targetRefRate = PALDevDataGet(Dev, targetRefRate);
+  uint32_t minimumSpadCount = 3;
+
+  if (pState->PeakSignalRateRef < targetRefRate) {
+    /* At this point, the minimum number of either aperture
+     * or non-aperture spads have been set. Proceed to add
+     * spads and perform measurements until the target
+     * reference is reached.
+     */
+    pState->IsApertureSpads = pState->NeedAptSpads;
+    pState->RefSpadCount = minimumSpadCount;
+
+    memcpy(pState->LastSpadArray, Dev->Data.SpadData.RefSpadEnables,
+           VL53L0X_REF_SPAD_BUFFER_SIZE);
+    pState->LastSignalRateDiff =
+        abs(pState->PeakSignalRateRef - targetRefRate);
+
+#if VL53L0X_REF_SPAD_LINEAR_SEARCH
+    return add_next_ref_spad(Dev, pState);
+#else
+    pState->SearchHigh = 0;
+    pState->SearchProbes = 0;
+    return start_ref_spad_probe(Dev, pState);
+#endif
+  }
+
+  store_ref_spad_result(Dev, pState);
+
+  return status;
+}
+
+void VL53L0X_calibration_init(VL53L0X_CalibrationState_t *pState,
+                              VL53L0X_CalibrationStep Step) {
+  memset(pState, 0, sizeof(VL53L0X_CalibrationState_t));
+  pState->Step = Step;
+}
+
+VL53L0X_Error VL53L0X_calibration_step(VL53L0X_DEV Dev,
+                                       VL53L0X_CalibrationState_t *pState) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
-  uint8_t lastSpadArray[6];
   uint8_t startSelect = 0xB4;
   uint32_t minimumSpadCount = 3;
   uint32_t maxSpadCount = 44;
-  uint32_t currentSpadIndex = 0;
   uint32_t lastSpadIndex = 0;
-  int32_t nextGoodSpad = 0;
-  uint16_t targetRefRate = 0x0A00; /* 20 MCPS in 9:7 format */
-  uint16_t peakSignalRateRef;
-  uint32_t needAptSpads = 0;
+  uint16_t targetRefRate = PALDevDataGet(Dev, targetRefRate);
   uint32_t index = 0;
   uint32_t spadArraySize = 6;
   uint32_t signalRateDiff = 0;
-  uint32_t lastSignalRateDiff = 0;
-  uint8_t complete = 0;
-  uint8_t VhvSettings = 0;
-  uint8_t PhaseCal = 0;
-  uint32_t refSpadCount_int = 0;
-  uint8_t isApertureSpads_int = 0;
+  uint8_t PhaseCalInt = 0;
+  uint8_t ready = 0;
+  uint8_t overshoot = 0;
 
   /*
-   * The reference SPAD initialization procedure determines the minimum
-   * amount of reference spads to be enables to achieve a target reference
-   * signal rate and should be performed once during initialization.
-   *
-   * Either aperture or non-aperture spads are applied but never both.
-   * Firstly non-aperture spads are set, beginning with 5 spads, and
-   * increased one spad at a time until the closest measurement to the
-   * target rate is achieved.
-   *
-   * If the target rate is exceeded when 5 non-aperture spads are enabled,
-   * initialization is performed instead with aperture spads.
-   *
-   * When setting spads, a 'Good Spad Map' is applied.
-   *
-   * This procedure operates within a SPAD window of interest of a maximum
-   * 44 spads.
-   * The start point is currently fixed to 180, which lies towards the end
-   * of the non-aperture quadrant and runs in to the adjacent aperture
-   * quadrant.
+   * Each call runs the I2C work of one step and returns. Steps that wait
+   * for a device side measurement check once for data ready and return
+   * without advancing when it is not there yet, so the caller can service
+   * other devices in the meantime.
    */
+  switch (pState->Step) {
+  case VL53L0X_CALSTEP_SPAD_START:
+    /*
+     * See VL53L0X_perform_ref_spad_management for the description of
+     * the procedure.
+     */
+    for (index = 0; index < spadArraySize; index++)
+      Dev->Data.SpadData.RefSpadEnables[index] = 0;
 
-  targetRefRate = PALDevDataGet(Dev, targetRefRate);
+    Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
 
-  /*
-   * Initialize Spad arrays.
-   * Currently the good spad map is initialised to 'All good'.
-   * This is a short term implementation. The good spad map will be
-   * provided as an input.
-   * Note that there are 6 bytes. Only the first 44 bits will be used to
-   * represent spads.
-   */
-  for (index = 0; index < spadArraySize; index++)
-    Dev->Data.SpadData.RefSpadEnables[index] = 0;
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_DYNAMIC_SPAD_REF_EN_START_OFFSET,
+                              0x00);
 
-  Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(
+          Dev, VL53L0X_REG_DYNAMIC_SPAD_NUM_REQUESTED_REF_SPAD, 0x2C);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status =
-        VL53L0X_WrByte(Dev, VL53L0X_REG_DYNAMIC_SPAD_REF_EN_START_OFFSET, 0x00);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(
-        Dev, VL53L0X_REG_DYNAMIC_SPAD_NUM_REQUESTED_REF_SPAD, 0x2C);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(
+          Dev, VL53L0X_REG_GLOBAL_CONFIG_REF_EN_START_SELECT, startSelect);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status =
+          VL53L0X_WrByte(Dev, VL53L0X_REG_POWER_MANAGEMENT_GO1_POWER_FORCE, 0);
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_GLOBAL_CONFIG_REF_EN_START_SELECT,
-                            startSelect);
+    /* Perform ref calibration, the data is not read back */
+    if (Status == VL53L0X_ERROR_NONE) {
+      pState->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0x01);
+    }
 
-  if (Status == VL53L0X_ERROR_NONE)
-    Status =
-        VL53L0X_WrByte(Dev, VL53L0X_REG_POWER_MANAGEMENT_GO1_POWER_FORCE, 0);
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_start_single_ref_calibration(Dev, 0x40);
 
-  /* Perform ref calibration */
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_perform_ref_calibration(Dev, &VhvSettings, &PhaseCal, 0);
+    pState->Step = VL53L0X_CALSTEP_SPAD_VHV;
+    break;
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    /* Enable Minimum NON-APERTURE Spads */
-    currentSpadIndex = 0;
-    lastSpadIndex = currentSpadIndex;
-    needAptSpads = 0;
-    Status = enable_ref_spads(
-        Dev, needAptSpads, Dev->Data.SpadData.RefGoodSpadMap,
-        Dev->Data.SpadData.RefSpadEnables, spadArraySize, startSelect,
-        currentSpadIndex, minimumSpadCount, &lastSpadIndex);
-  }
+  case VL53L0X_CALSTEP_SPAD_VHV:
+  case VL53L0X_CALSTEP_REF_VHV:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    currentSpadIndex = lastSpadIndex;
+    Status = VL53L0X_end_single_ref_calibration(Dev);
 
-    Status = perform_ref_signal_measurement(Dev, &peakSignalRateRef);
-    if ((Status == VL53L0X_ERROR_NONE) && (peakSignalRateRef > targetRefRate)) {
-      /* Signal rate measurement too high,
-       * switch to APERTURE SPADs */
+    /* Read VHV from device */
+    if ((Status == VL53L0X_ERROR_NONE) &&
+        (pState->Step == VL53L0X_CALSTEP_REF_VHV))
+      Status = VL53L0X_ref_calibration_io(Dev, 1, 0, 0, &pState->VhvSettings,
+                                          &PhaseCalInt, 1, 0);
 
-      for (index = 0; index < spadArraySize; index++)
-        Dev->Data.SpadData.RefSpadEnables[index] = 0;
+    /* Run PhaseCal */
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0x02);
 
-      /* Increment to the first APERTURE spad */
-      while ((is_aperture(startSelect + currentSpadIndex) == 0) &&
-             (currentSpadIndex < maxSpadCount)) {
-        currentSpadIndex++;
-      }
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_start_single_ref_calibration(Dev, 0x0);
+
+    pState->Step++;
+    break;
+
+  case VL53L0X_CALSTEP_SPAD_PHASE:
+  case VL53L0X_CALSTEP_REF_PHASE:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
 
-      needAptSpads = 1;
+    Status = VL53L0X_end_single_ref_calibration(Dev);
 
+    /* Read PhaseCal from device */
+    if ((Status == VL53L0X_ERROR_NONE) &&
+        (pState->Step == VL53L0X_CALSTEP_REF_PHASE))
+      Status = VL53L0X_ref_calibration_io(Dev, 1, 0, 0, &PhaseCalInt,
+                                          &pState->PhaseCal, 0, 1);
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      /* restore the previous Sequence Config */
+      Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG,
+                              pState->SequenceConfig);
+      if (Status == VL53L0X_ERROR_NONE)
+        PALDevDataSet(Dev, SequenceConfig, pState->SequenceConfig);
+    }
+
+    if (pState->Step == VL53L0X_CALSTEP_REF_PHASE) {
+      pState->Step = VL53L0X_CALSTEP_DONE;
+      break;
+    }
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      /* Enable Minimum NON-APERTURE Spads */
+      pState->CurrentSpadIndex = 0;
+      lastSpadIndex = pState->CurrentSpadIndex;
+      pState->NeedAptSpads = 0;
       Status = enable_ref_spads(
-          Dev, needAptSpads, Dev->Data.SpadData.RefGoodSpadMap,
+          Dev, pState->NeedAptSpads, Dev->Data.SpadData.RefGoodSpadMap,
           Dev->Data.SpadData.RefSpadEnables, spadArraySize, startSelect,
-          currentSpadIndex, minimumSpadCount, &lastSpadIndex);
+          pState->CurrentSpadIndex, minimumSpadCount, &lastSpadIndex);
+    }
 
-      if (Status == VL53L0X_ERROR_NONE) {
-        currentSpadIndex = lastSpadIndex;
-        Status = perform_ref_signal_measurement(Dev, &peakSignalRateRef);
-
-        if ((Status == VL53L0X_ERROR_NONE) &&
-            (peakSignalRateRef > targetRefRate)) {
-          /* Signal rate still too high after
-           * setting the minimum number of
-           * APERTURE spads. Can do no more
-           * therefore set the min number of
-           * aperture spads as the result.
-           */
-          isApertureSpads_int = 1;
-          refSpadCount_int = minimumSpadCount;
-        }
-      }
-    } else {
-      needAptSpads = 0;
+    if (Status == VL53L0X_ERROR_NONE) {
+      pState->CurrentSpadIndex = lastSpadIndex;
+      Status = start_ref_signal_measurement(Dev, pState);
     }
-  }
 
-  if ((Status == VL53L0X_ERROR_NONE) && (peakSignalRateRef < targetRefRate)) {
-    /* At this point, the minimum number of either aperture
-     * or non-aperture spads have been set. Proceed to add
-     * spads and perform measurements until the target
-     * reference is reached.
-     */
-    isApertureSpads_int = needAptSpads;
-    refSpadCount_int = minimumSpadCount;
+    pState->Step = VL53L0X_CALSTEP_SPAD_MIN;
+    break;
 
-    memcpy(lastSpadArray, Dev->Data.SpadData.RefSpadEnables, spadArraySize);
-    lastSignalRateDiff = abs(peakSignalRateRef - targetRefRate);
-    complete = 0;
+  case VL53L0X_CALSTEP_SPAD_MIN:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
 
-    while (!complete) {
-      get_next_good_spad(Dev->Data.SpadData.RefGoodSpadMap, spadArraySize,
-                         currentSpadIndex, &nextGoodSpad);
+    Status = finish_ref_signal_measurement(Dev, pState);
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
 
-      if (nextGoodSpad == -1) {
-        Status = VL53L0X_ERROR_REF_SPAD_INIT;
-        break;
-      }
+    if (pState->PeakSignalRateRef <= targetRefRate) {
+      pState->NeedAptSpads = 0;
+      Status = end_ref_spad_search(Dev, pState);
+      break;
+    }
+
+    /* Signal rate measurement too high,
+     * switch to APERTURE SPADs */
+    for (index = 0; index < spadArraySize; index++)
+      Dev->Data.SpadData.RefSpadEnables[index] = 0;
+
+    /* Increment to the first APERTURE spad */
+    while ((is_aperture(startSelect + pState->CurrentSpadIndex) == 0) &&
+           (pState->CurrentSpadIndex < maxSpadCount)) {
+      pState->CurrentSpadIndex++;
+    }
 
-      (refSpadCount_int)++;
+    pState->NeedAptSpads = 1;
 
-      /* Cannot combine Aperture and Non-Aperture spads, so
-       * ensure the current spad is of the correct type.
+    Status = enable_ref_spads(
+        Dev, pState->NeedAptSpads, Dev->Data.SpadData.RefGoodSpadMap,
+        Dev->Data.SpadData.RefSpadEnables, spadArraySize, startSelect,
+        pState->CurrentSpadIndex, minimumSpadCount, &lastSpadIndex);
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      pState->CurrentSpadIndex = lastSpadIndex;
+      Status = start_ref_signal_measurement(Dev, pState);
+    }
+
+    pState->Step = VL53L0X_CALSTEP_SPAD_MIN_APT;
+    break;
+
+  case VL53L0X_CALSTEP_SPAD_MIN_APT:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
+
+    Status = finish_ref_signal_measurement(Dev, pState);
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
+
+    if (pState->PeakSignalRateRef > targetRefRate) {
+      /* Signal rate still too high after
+       * setting the minimum number of
+       * APERTURE spads. Can do no more
+       * therefore set the min number of
+       * aperture spads as the result.
        */
-      if (is_aperture((uint32_t)startSelect + nextGoodSpad) != needAptSpads) {
-        Status = VL53L0X_ERROR_REF_SPAD_INIT;
-        break;
+      pState->IsApertureSpads = 1;
+      pState->RefSpadCount = minimumSpadCount;
+    }
+
+    Status = end_ref_spad_search(Dev, pState);
+    break;
+
+  case VL53L0X_CALSTEP_SPAD_ADD:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
+
+    Status = finish_ref_signal_measurement(Dev, pState);
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
+
+    signalRateDiff = abs(pState->PeakSignalRateRef - targetRefRate);
+
+    if (pState->PeakSignalRateRef > targetRefRate) {
+      /* Select the spad map that provides the
+       * measurement closest to the target rate,
+       * either above or below it.
+       */
+      if (signalRateDiff > pState->LastSignalRateDiff) {
+        /* Previous spad map produced a closer
+         * measurement, so choose this. */
+        Status = set_ref_spad_map(Dev, pState->LastSpadArray);
+        memcpy(Dev->Data.SpadData.RefSpadEnables, pState->LastSpadArray,
+               spadArraySize);
+
+        (pState->RefSpadCount)--;
       }
 
-      currentSpadIndex = nextGoodSpad;
-      Status = enable_spad_bit(Dev->Data.SpadData.RefSpadEnables, spadArraySize,
-                               currentSpadIndex);
+      if (Status == VL53L0X_ERROR_NONE)
+        Status = end_ref_spad_search(Dev, pState);
+    } else {
+      /* Continue to add spads */
+      pState->LastSignalRateDiff = signalRateDiff;
+      memcpy(pState->LastSpadArray, Dev->Data.SpadData.RefSpadEnables,
+             spadArraySize);
+
+      Status = add_next_ref_spad(Dev, pState);
+    }
+    break;
 
-      if (Status == VL53L0X_ERROR_NONE) {
-        currentSpadIndex++;
-        /* Proceed to apply the additional spad and
-         * perform measurement. */
+  case VL53L0X_CALSTEP_SPAD_SEARCH:
+    Status = calibration_poll(Dev, pState, &ready);
+    if ((Status != VL53L0X_ERROR_NONE) || !ready)
+      break;
+
+    Status = finish_ref_signal_measurement(Dev, pState);
+    if (Status != VL53L0X_ERROR_NONE)
+      break;
+
+    signalRateDiff = abs(pState->PeakSignalRateRef - targetRefRate);
+    overshoot = (pState->PeakSignalRateRef > targetRefRate);
+
+    if (overshoot) {
+      pState->SearchHigh = pState->SearchStep;
+      pState->HighSignalRateDiff = signalRateDiff;
+    } else {
+      /* The measured map becomes the lower end of the bracket */
+      append_good_spads(Dev->Data.SpadData.RefGoodSpadMap,
+                        pState->LastSpadArray, spadArraySize, startSelect,
+                        pState->NeedAptSpads, pState->CurrentSpadIndex,
+                        pState->SearchStep, &pState->CurrentSpadIndex);
+      pState->RefSpadCount += pState->SearchStep;
+      pState->LastSignalRateDiff = signalRateDiff;
+      if (pState->SearchHigh > 0)
+        pState->SearchHigh -= pState->SearchStep;
+    }
+
+    if (pState->SearchHigh != 1) {
+      Status = start_ref_spad_probe(Dev, pState);
+      break;
+    }
+
+    /* One spad apart, keep the map closest to the target rate, the larger
+     * one on a tie as the linear walk does. Only write it when it is not
+     * the one just measured. */
+    memcpy(Dev->Data.SpadData.RefSpadEnables, pState->LastSpadArray,
+           spadArraySize);
+    if (pState->HighSignalRateDiff <= pState->LastSignalRateDiff) {
+      append_good_spads(Dev->Data.SpadData.RefGoodSpadMap,
+                        Dev->Data.SpadData.RefSpadEnables, spadArraySize,
+                        startSelect, pState->NeedAptSpads,
+                        pState->CurrentSpadIndex, 1, &lastSpadIndex);
+      (pState->RefSpadCount)++;
+      if (!overshoot)
         Status = set_ref_spad_map(Dev, Dev->Data.SpadData.RefSpadEnables);
-      }
+    } else if (overshoot) {
+      Status = set_ref_spad_map(Dev, Dev->Data.SpadData.RefSpadEnables);
+    }
 
-      if (Status != VL53L0X_ERROR_NONE)
-        break;
+    if (Status == VL53L0X_ERROR_NONE)
+      store_ref_spad_result(Dev, pState);
+    break;
 
-      Status = perform_ref_signal_measurement(Dev, &peakSignalRateRef);
+  case VL53L0X_CALSTEP_REF_START:
+    /* store the value of the sequence config,
+     * this will be reset once the phase calibration is over
+     */
+    pState->SequenceConfig = PALDevDataGet(Dev, SequenceConfig);
 
-      if (Status != VL53L0X_ERROR_NONE)
-        break;
+    /* Run VHV */
+    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 0x01);
 
-      signalRateDiff = abs(peakSignalRateRef - targetRefRate);
-
-      if (peakSignalRateRef > targetRefRate) {
-        /* Select the spad map that provides the
-         * measurement closest to the target rate,
-         * either above or below it.
-         */
-        if (signalRateDiff > lastSignalRateDiff) {
-          /* Previous spad map produced a closer
-           * measurement, so choose this. */
-          Status = set_ref_spad_map(Dev, lastSpadArray);
-          memcpy(Dev->Data.SpadData.RefSpadEnables, lastSpadArray,
-                 spadArraySize);
-
-          (refSpadCount_int)--;
-        }
-        complete = 1;
-      } else {
-        /* Continue to add spads */
-        lastSignalRateDiff = signalRateDiff;
-        memcpy(lastSpadArray, Dev->Data.SpadData.RefSpadEnables, spadArraySize);
-      }
+    if (Status == VL53L0X_ERROR_NONE)
+      Status = VL53L0X_start_single_ref_calibration(Dev, 0x40);
+
+    pState->Step = VL53L0X_CALSTEP_REF_VHV;
+    break;
 
-    } /* while */
+  default:
+    pState->Step = VL53L0X_CALSTEP_DONE;
+    break;
   }
 
-  if (Status == VL53L0X_ERROR_NONE) {
-    *refSpadCount = refSpadCount_int;
-    *isApertureSpads = isApertureSpads_int;
+  return Status;
+}
 
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, RefSpadsInitialised, 1);
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount,
-                                       (uint8_t)(*refSpadCount));
-    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType,
-                                       *isApertureSpads);
+VL53L0X_Error VL53L0X_perform_ref_spad_management(VL53L0X_DEV Dev,
+                                                  uint32_t *refSpadCount,
+                                                  uint8_t *isApertureSpads) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_CalibrationState_t State;
+
+  /*
+   * The reference SPAD initialization procedure determines the minimum
+   * amount of reference spads to be enables to achieve a target reference
+   * signal rate and should be performed once during initialization.
+   *
+   * Either aperture or non-aperture spads are applied but never both.
+   * Firstly non-aperture spads are set, beginning with 5 spads, and
+   * increased until the closest measurement to the target rate is
+   * achieved. The count where the target is crossed is bracketed and the
+   * bracket halved, see start_ref_spad_probe, unless
+   * VL53L0X_REF_SPAD_LINEAR_SEARCH asks for one spad at a time.
+   *
+   * If the target rate is exceeded when 5 non-aperture spads are enabled,
+   * initialization is performed instead with aperture spads.
+   *
+   * When setting spads, a 'Good Spad Map' is applied.
+   *
+   * This procedure operates within a SPAD window of interest of a maximum
+   * 44 spads.
+   * The start point is currently fixed to 180, which lies towards the end
+   * of the non-aperture quadrant and runs in to the adjacent aperture
+   * quadrant.
+   *
+   * The procedure itself is implemented by VL53L0X_calibration_step, here
+   * the steps are simply run back to back.
+   */
+  VL53L0X_calibration_init(&State, VL53L0X_CALSTEP_SPAD_START);
+
+  do {
+    Status = VL53L0X_calibration_step(Dev, &State);
+  } while ((Status == VL53L0X_ERROR_NONE) &&
+           (State.Step != VL53L0X_CALSTEP_DONE));
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    *refSpadCount = State.RefSpadCount;
+    *isApertureSpads = State.IsApertureSpads;
   }
 
   return Status;
@@ -956,23 +1444,39 @@ VL53L0X_Error VL53L0X_get_reference_spads(VL53L0X_DEV Dev, uint32_t *pSpadCount,
   return Status;
 }
 
+VL53L0X_Error VL53L0X_start_single_ref_calibration(VL53L0X_DEV Dev,
+                                                   uint8_t vhv_init_byte) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+  Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
+                          VL53L0X_REG_SYSRANGE_MODE_START_STOP | vhv_init_byte);
+
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_end_single_ref_calibration(VL53L0X_DEV Dev) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+  Status = VL53L0X_ClearInterruptMask(Dev, 0);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START, 0x00);
+
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_perform_single_ref_calibration(VL53L0X_DEV Dev,
                                                      uint8_t vhv_init_byte) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
 
   if (Status == VL53L0X_ERROR_NONE)
-    Status =
-        VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START,
-                       VL53L0X_REG_SYSRANGE_MODE_START_STOP | vhv_init_byte);
+    Status = VL53L0X_start_single_ref_calibration(Dev, vhv_init_byte);
 
   if (Status == VL53L0X_ERROR_NONE)
     Status = VL53L0X_measurement_poll_for_completion(Dev);
 
   if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_ClearInterruptMask(Dev, 0);
-
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, VL53L0X_REG_SYSRANGE_START, 0x00);
+    Status = VL53L0X_end_single_ref_calibration(Dev);
 
   return Status;
 }
@@ -982,28 +1486,31 @@ VL53L0X_Error VL53L0X_ref_calibration_io(
     uint8_t PhaseCal, uint8_t *pVhvSettings, uint8_t *pPhaseCal,
     const uint8_t vhv_enable, const uint8_t phase_enable) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
   uint8_t PhaseCalint = 0;
 
   /* Read VHV from device */
-  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-  Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
-  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
+  VL53L0X_batch_init(&Batch);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x01);
+  VL53L0X_batch_write(&Batch, 0x00, 0x00);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x00);
 
   if (read_not_write) {
     if (vhv_enable)
-      Status |= VL53L0X_RdByte(Dev, 0xCB, pVhvSettings);
+      VL53L0X_batch_read(&Batch, 0xCB, pVhvSettings, 1);
     if (phase_enable)
-      Status |= VL53L0X_RdByte(Dev, 0xEE, &PhaseCalint);
+      VL53L0X_batch_read(&Batch, 0xEE, &PhaseCalint, 1);
   } else {
     if (vhv_enable)
-      Status |= VL53L0X_WrByte(Dev, 0xCB, VhvSettings);
+      VL53L0X_batch_write(&Batch, 0xCB, VhvSettings);
     if (phase_enable)
-      Status |= VL53L0X_UpdateByte(Dev, 0xEE, 0x80, PhaseCal);
+      VL53L0X_batch_update(&Batch, 0xEE, 0x80, PhaseCal);
   }
 
-  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-  Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
-  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x01);
+  VL53L0X_batch_write(&Batch, 0x00, 0x01);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x00);
+  Status = VL53L0X_batch_submit(Dev, &Batch);
 
   *pPhaseCal = (uint8_t)(PhaseCalint & 0xEF);
 
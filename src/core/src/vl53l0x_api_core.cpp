@@ -56,13 +56,37 @@ VL53L0X_Error VL53L0X_reverse_bytes(uint8_t *data, uint32_t size) {
   return Status;
 }
 
+uint8_t VL53L0X_gpio_data_ready_enabled(VL53L0X_DEV Dev) {
+  return (Dev->GpioLevelHook != NULL) &&
+         (VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Pin0GpioFunctionality) ==
+          VL53L0X_REG_SYSTEM_INTERRUPT_GPIO_NEW_SAMPLE_READY);
+}
+
 VL53L0X_Error VL53L0X_measurement_poll_for_completion(VL53L0X_DEV Dev) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   uint8_t NewDataReady = 0;
+  uint8_t PinPolled;
   uint32_t LoopNb;
+  uint32_t StartMs = 0;
+  uint32_t NowMs = 0;
+  uint32_t TimeoutMs = 0;
 
   LOG_FUNCTION_START("");
 
+  /* Pin reads are too quick to count them, time the wait instead. A range
+   * ends within a budget once the inter measurement period is over */
+  PinPolled = VL53L0X_gpio_data_ready_enabled(Dev);
+  if (PinPolled) {
+    TimeoutMs = (PALDevDataGet(Dev, CurrentParameters)
+                     .MeasurementTimingBudgetMicroSeconds +
+                 999) /
+                1000;
+    TimeoutMs += PALDevDataGet(Dev, CurrentParameters)
+                     .InterMeasurementPeriodMilliSeconds;
+    TimeoutMs = 2 * TimeoutMs + 10;
+    VL53L0X_GetTickCount(&StartMs);
+  }
+
   LoopNb = 0;
 
   do {
@@ -73,10 +97,18 @@ VL53L0X_Error VL53L0X_measurement_poll_for_completion(VL53L0X_DEV Dev) {
     if (NewDataReady == 1)
       break; /* done note that status == 0 */
 
-    LoopNb++;
-    if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP) {
-      Status = VL53L0X_ERROR_TIME_OUT;
-      break;
+    if (PinPolled) {
+      VL53L0X_GetTickCount(&NowMs);
+      if ((NowMs - StartMs) > TimeoutMs) {
+        Status = VL53L0X_ERROR_TIME_OUT;
+        break;
+      }
+    } else {
+      LoopNb++;
+      if (LoopNb >= VL53L0X_DEFAULT_MAX_LOOP) {
+        Status = VL53L0X_ERROR_TIME_OUT;
+        break;
+      }
     }
 
     VL53L0X_PollingDelay(Dev);
@@ -193,6 +225,96 @@ VL53L0X_Error VL53L0X_device_read_strobe(VL53L0X_DEV Dev) {
   return Status;
 }
 
+VL53L0X_Error
+VL53L0X_get_device_signature(VL53L0X_DEV Dev,
+                             VL53L0X_DeviceSignature_t *pSignature) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
+  memset(pSignature, 0, sizeof(VL53L0X_DeviceSignature_t));
+
+  Status = VL53L0X_RdByte(Dev, VL53L0X_REG_IDENTIFICATION_MODEL_ID,
+                          &pSignature->ModelId);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_RdByte(Dev, VL53L0X_REG_I2C_SLAVE_DEVICE_ADDRESS,
+                            &pSignature->I2cAddress);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    /* Same access sequence as VL53L0X_DataInit() */
+    Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
+    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
+    Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
+    Status |= VL53L0X_RdByte(Dev, 0x91, &pSignature->StopVariable);
+    Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
+    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
+    Status |= VL53L0X_WrByte(Dev, 0x80, 0x00);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_RdByte(Dev, VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG,
+                            &pSignature->SequenceConfig);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_RdByte(Dev, VL53L0X_REG_SYSTEM_INTERRUPT_CONFIG_GPIO,
+                            &pSignature->GpioConfig);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_RdByte(Dev, VL53L0X_REG_PRE_RANGE_CONFIG_VCSEL_PERIOD,
+                            &pSignature->PreRangeVcselPeriod);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_RdByte(Dev, VL53L0X_REG_FINAL_RANGE_CONFIG_VCSEL_PERIOD,
+                            &pSignature->FinalRangeVcselPeriod);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status =
+        VL53L0X_ReadMulti(Dev, VL53L0X_REG_GLOBAL_CONFIG_SPAD_ENABLES_REF_0,
+                          pSignature->RefSpadEnables,
+                          VL53L0X_REF_SPAD_BUFFER_SIZE);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+static VL53L0X_Error nvm_access_start(VL53L0X_DEV Dev) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint8_t byte;
+
+  Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
+  Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
+
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
+  Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
+  Status |= VL53L0X_WrByte(Dev, 0x83, byte | 4);
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x07);
+  Status |= VL53L0X_WrByte(Dev, 0x81, 0x01);
+
+  Status |= VL53L0X_PollingDelay(Dev);
+
+  Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
+
+  return Status;
+}
+
+static VL53L0X_Error nvm_access_stop(VL53L0X_DEV Dev) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint8_t byte;
+
+  Status |= VL53L0X_WrByte(Dev, 0x81, 0x00);
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
+  Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
+  Status |= VL53L0X_WrByte(Dev, 0x83, byte & 0xfb);
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
+  Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
+
+  Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
+  Status |= VL53L0X_WrByte(Dev, 0x80, 0x00);
+
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option) {
 
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
@@ -225,19 +347,7 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option) {
    * datainit is done*/
   if (ReadDataFromDeviceDone != 7) {
 
-    Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-    Status |= VL53L0X_WrByte(Dev, 0x00, 0x00);
-
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
-    Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
-    Status |= VL53L0X_WrByte(Dev, 0x83, byte | 4);
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x07);
-    Status |= VL53L0X_WrByte(Dev, 0x81, 0x01);
-
-    Status |= VL53L0X_PollingDelay(Dev);
-
-    Status |= VL53L0X_WrByte(Dev, 0x80, 0x01);
+    Status |= nvm_access_start(Dev);
 
     if (((option & 1) == 1) && ((ReadDataFromDeviceDone & 1) == 0)) {
       Status |= VL53L0X_WrByte(Dev, 0x94, 0x6b);
@@ -359,15 +469,7 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option) {
       DistMeasFixed1104_400_mm |= ((TmpDWord & 0xff000000) >> 24);
     }
 
-    Status |= VL53L0X_WrByte(Dev, 0x81, 0x00);
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x06);
-    Status |= VL53L0X_RdByte(Dev, 0x83, &byte);
-    Status |= VL53L0X_WrByte(Dev, 0x83, byte & 0xfb);
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x01);
-    Status |= VL53L0X_WrByte(Dev, 0x00, 0x01);
-
-    Status |= VL53L0X_WrByte(Dev, 0xFF, 0x00);
-    Status |= VL53L0X_WrByte(Dev, 0x80, 0x00);
+    Status |= nvm_access_stop(Dev);
   }
 
   if ((Status == VL53L0X_ERROR_NONE) && (ReadDataFromDeviceDone != 7)) {
@@ -422,6 +524,134 @@ VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option) {
   return Status;
 }
 
+VL53L0X_Error VL53L0X_get_part_uid(VL53L0X_DEV Dev, uint32_t *pPartUIDUpper,
+                                   uint32_t *pPartUIDLower) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  LOG_FUNCTION_START("");
+
+  /* Only the two UID words, not the whole of VL53L0X_get_info_from_device */
+  Status |= nvm_access_start(Dev);
+
+  Status |= VL53L0X_WrByte(Dev, 0x94, 0x7B);
+  Status |= VL53L0X_device_read_strobe(Dev);
+  Status |= VL53L0X_RdDWord(Dev, 0x90, pPartUIDUpper);
+
+  Status |= VL53L0X_WrByte(Dev, 0x94, 0x7C);
+  Status |= VL53L0X_device_read_strobe(Dev);
+  Status |= VL53L0X_RdDWord(Dev, 0x90, pPartUIDLower);
+
+  Status |= nvm_access_stop(Dev);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_get_nvm_info(VL53L0X_DEV Dev,
+                                   VL53L0X_NvmInfo_t *pNvmInfo) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  char *ProductId_tmp;
+  int i;
+  LOG_FUNCTION_START("");
+
+  /* Does not access the device if everything was read already */
+  Status = VL53L0X_get_info_from_device(Dev, 7);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    pNvmInfo->PartUIDUpper =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PartUIDUpper);
+    pNvmInfo->PartUIDLower =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PartUIDLower);
+    pNvmInfo->SignalRateMeasFixed400mm =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, SignalRateMeasFixed400mm);
+    pNvmInfo->OffsetMicroMeters =
+        PALDevDataGet(Dev, Part2PartOffsetAdjustmentNVMMicroMeter);
+    pNvmInfo->ModuleId = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ModuleId);
+    pNvmInfo->Revision = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, Revision);
+    pNvmInfo->ReferenceSpadCount =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount);
+    pNvmInfo->ReferenceSpadType =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType);
+
+    for (i = 0; i < VL53L0X_REF_SPAD_BUFFER_SIZE; i++)
+      pNvmInfo->RefGoodSpadMap[i] = Dev->Data.SpadData.RefGoodSpadMap[i];
+
+    ProductId_tmp = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ProductId);
+    for (i = 0; i < VL53L0X_NVM_PRODUCT_ID_LENGTH - 1; i++)
+      pNvmInfo->ProductId[i] = ProductId_tmp[i];
+    pNvmInfo->ProductId[VL53L0X_NVM_PRODUCT_ID_LENGTH - 1] = '\0';
+
+    pNvmInfo->Valid = 1;
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_set_nvm_info(VL53L0X_DEV Dev,
+                                   const VL53L0X_NvmInfo_t *pNvmInfo) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  char *ProductId_tmp;
+  int i;
+  LOG_FUNCTION_START("");
+
+  if (pNvmInfo->Valid != 1)
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+
+  /* The image comes back from host storage, only take what the NVM fields
+   * can hold: 7 bit SPAD count and 1 bit type, a 9.7 signal rate, the
+   * 16 bit offset and a 7 bit ASCII product ID that ends in the array */
+  if ((Status == VL53L0X_ERROR_NONE) &&
+      ((pNvmInfo->ReferenceSpadCount > 0x7F) ||
+       (pNvmInfo->ReferenceSpadType > 1) ||
+       (pNvmInfo->SignalRateMeasFixed400mm >
+        VL53L0X_FIXPOINT97TOFIXPOINT1616(0xFFFF)) ||
+       (pNvmInfo->OffsetMicroMeters < -32768) ||
+       (pNvmInfo->OffsetMicroMeters > 32767)))
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+
+  for (i = 0; (Status == VL53L0X_ERROR_NONE) &&
+              (pNvmInfo->ProductId[i] != '\0');
+       i++) {
+    if ((i == VL53L0X_NVM_PRODUCT_ID_LENGTH - 1) ||
+        ((uint8_t)pNvmInfo->ProductId[i] > 0x7F))
+      Status = VL53L0X_ERROR_INVALID_PARAMS;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PartUIDUpper,
+                                       pNvmInfo->PartUIDUpper);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PartUIDLower,
+                                       pNvmInfo->PartUIDLower);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, SignalRateMeasFixed400mm,
+                                       pNvmInfo->SignalRateMeasFixed400mm);
+    PALDevDataSet(Dev, Part2PartOffsetAdjustmentNVMMicroMeter,
+                  pNvmInfo->OffsetMicroMeters);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ModuleId, pNvmInfo->ModuleId);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, Revision, pNvmInfo->Revision);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadCount,
+                                       pNvmInfo->ReferenceSpadCount);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReferenceSpadType,
+                                       pNvmInfo->ReferenceSpadType);
+
+    for (i = 0; i < VL53L0X_REF_SPAD_BUFFER_SIZE; i++)
+      Dev->Data.SpadData.RefGoodSpadMap[i] = pNvmInfo->RefGoodSpadMap[i];
+
+    /* bounded by the checks above, the destination is at least as long */
+    ProductId_tmp = VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, ProductId);
+    for (i = 0; (i < VL53L0X_NVM_PRODUCT_ID_LENGTH - 1) &&
+                (pNvmInfo->ProductId[i] != '\0');
+         i++)
+      ProductId_tmp[i] = pNvmInfo->ProductId[i];
+    ProductId_tmp[i] = '\0';
+
+    /* Everything VL53L0X_get_info_from_device() reads is known now */
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, ReadDataFromDeviceDone, 7);
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
 uint32_t VL53L0X_calc_macro_period_ps(VL53L0X_DEV Dev,
                                       uint8_t vcsel_period_pclks) {
   uint64_t PLL_period_ps;
@@ -936,6 +1166,150 @@ VL53L0X_set_vcsel_pulse_period(VL53L0X_DEV Dev,
   return Status;
 }
 
+/* Register blocks that make up a profile: start index and length. Every
+ * register written by VL53L0X_set_vcsel_pulse_period(), the timing budget
+ * and the limit checks is in one of them. */
+static const uint8_t profile_register_blocks[][2] = {
+    {VL53L0X_REG_SYSTEM_SEQUENCE_CONFIG, 1},
+    {VL53L0X_REG_ALGO_PHASECAL_CONFIG_TIMEOUT, 1},
+    {VL53L0X_REG_GLOBAL_CONFIG_VCSEL_WIDTH, 1},
+    /* min count rate (2), MSRC timeout, final range valid phase (2) */
+    {VL53L0X_REG_FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT, 5},
+    /* pre-range VCSEL period, pre-range timeout (2) */
+    {VL53L0X_REG_PRE_RANGE_CONFIG_VCSEL_PERIOD, 3},
+    {VL53L0X_REG_PRE_RANGE_CONFIG_VALID_PHASE_LOW, 2},
+    {VL53L0X_REG_MSRC_CONFIG_CONTROL, 1},
+    /* MSRC and pre-range signal rate limit (2) */
+    {VL53L0X_REG_PRE_RANGE_MIN_COUNT_RATE_RTN_LIMIT, 2},
+    /* final range VCSEL period, final range timeout (2) */
+    {VL53L0X_REG_FINAL_RANGE_CONFIG_VCSEL_PERIOD, 3}};
+
+#define PROFILE_REGISTER_BLOCKS                                                \
+  (sizeof(profile_register_blocks) / sizeof(profile_register_blocks[0]))
+
+VL53L0X_Error VL53L0X_capture_profile(VL53L0X_DEV Dev,
+                                      VL53L0X_Profile_t *pProfile) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint8_t *pRegister = pProfile->Registers;
+  uint8_t VhvSettings;
+  uint32_t i;
+
+  LOG_FUNCTION_START("");
+
+  pProfile->Valid = 0;
+
+  for (i = 0; (i < PROFILE_REGISTER_BLOCKS) && (Status == VL53L0X_ERROR_NONE);
+       i++) {
+    Status = VL53L0X_ReadMulti(Dev, profile_register_blocks[i][0], pRegister,
+                               profile_register_blocks[i][1]);
+    pRegister += profile_register_blocks[i][1];
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status |= VL53L0X_WrByte(Dev, 0xff, 0x01);
+    Status |= VL53L0X_RdByte(Dev, VL53L0X_REG_ALGO_PHASECAL_LIM,
+                             &pProfile->PhasecalLimit);
+    Status |= VL53L0X_WrByte(Dev, 0xff, 0x00);
+  }
+
+  /* Left in the device by the phase calibration of
+   * VL53L0X_set_vcsel_pulse_period() */
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_ref_calibration_io(Dev, 1, 0, 0, &VhvSettings,
+                                        &pProfile->PhaseCal, 0, 1);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
+      VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, i,
+                                     pProfile->LimitChecksEnable[i]);
+      VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksValue, i,
+                                     pProfile->LimitChecksValue[i]);
+    }
+    VL53L0X_GETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              pProfile->MeasurementTimingBudgetMicroSeconds);
+
+    pProfile->PreRangeVcselPulsePeriod =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod);
+    pProfile->FinalRangeVcselPulsePeriod =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod);
+    pProfile->PreRangeTimeoutMicroSecs =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs);
+    pProfile->FinalRangeTimeoutMicroSecs =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs);
+    pProfile->LastEncodedTimeout =
+        VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, LastEncodedTimeout);
+
+    pProfile->Valid = VL53L0X_PROFILE_CAPTURED;
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_apply_profile(VL53L0X_DEV Dev,
+                                    const VL53L0X_Profile_t *pProfile) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint8_t *pRegister = (uint8_t *)pProfile->Registers;
+  uint8_t VhvSettings;
+  uint8_t PhaseCal;
+  uint32_t i;
+
+  LOG_FUNCTION_START("");
+
+  if ((pProfile->Valid != VL53L0X_PROFILE_CAPTURED) &&
+      (pProfile->Valid != VL53L0X_PROFILE_BUILT))
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+
+  for (i = 0; (i < PROFILE_REGISTER_BLOCKS) && (Status == VL53L0X_ERROR_NONE);
+       i++) {
+    Status = VL53L0X_WriteMulti(Dev, profile_register_blocks[i][0], pRegister,
+                                profile_register_blocks[i][1]);
+    pRegister += profile_register_blocks[i][1];
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    Status |= VL53L0X_WrByte(Dev, 0xff, 0x01);
+    Status |= VL53L0X_WrByte(Dev, VL53L0X_REG_ALGO_PHASECAL_LIM,
+                             pProfile->PhasecalLimit);
+    Status |= VL53L0X_WrByte(Dev, 0xff, 0x00);
+  }
+
+  /* Instead of a new phase calibration measurement. A built profile
+   * leaves that to the caller. */
+  if ((Status == VL53L0X_ERROR_NONE) &&
+      (pProfile->Valid == VL53L0X_PROFILE_CAPTURED))
+    Status = VL53L0X_ref_calibration_io(Dev, 0, 0, pProfile->PhaseCal,
+                                        &VhvSettings, &PhaseCal, 0, 1);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
+      VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, i,
+                                     pProfile->LimitChecksEnable[i]);
+      VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, i,
+                                     pProfile->LimitChecksValue[i]);
+    }
+    VL53L0X_SETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                              pProfile->MeasurementTimingBudgetMicroSeconds);
+
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod,
+                                       pProfile->PreRangeVcselPulsePeriod);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod,
+                                       pProfile->FinalRangeVcselPulsePeriod);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs,
+                                       pProfile->PreRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs,
+                                       pProfile->FinalRangeTimeoutMicroSecs);
+    VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, LastEncodedTimeout,
+                                       pProfile->LastEncodedTimeout);
+
+    /* The sequence config is the first register of the image */
+    PALDevDataSet(Dev, SequenceConfig, pProfile->Registers[0]);
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
 VL53L0X_Error
 VL53L0X_get_vcsel_pulse_period(VL53L0X_DEV Dev,
                                VL53L0X_VcselPeriod VcselPeriodType,
@@ -1094,6 +1468,118 @@ VL53L0X_Error VL53L0X_set_measurement_timing_budget_micro_seconds(
   return Status;
 }
 
+VL53L0X_Error VL53L0X_get_budget_plan(VL53L0X_DEV Dev,
+                                      VL53L0X_BudgetPlan_t *pPlan) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_SchedulerSequenceSteps_t SchedulerSequenceSteps;
+  uint32_t MsrcDccTccTimeoutMicroSeconds = 2000;
+  uint32_t StartOverheadMicroSeconds = 1320;
+  uint32_t EndOverheadMicroSeconds = 960;
+  uint32_t MsrcOverheadMicroSeconds = 660;
+  uint32_t TccOverheadMicroSeconds = 590;
+  uint32_t DssOverheadMicroSeconds = 690;
+  uint32_t PreRangeOverheadMicroSeconds = 660;
+  uint32_t PreRangeTimeoutMicroSeconds = 0;
+  uint16_t PreRangeEncodedTimeOut;
+
+  LOG_FUNCTION_START("");
+
+  /* Same sums as VL53L0X_set_measurement_timing_budget_micro_seconds() */
+  pPlan->OverheadMicroSeconds =
+      StartOverheadMicroSeconds + EndOverheadMicroSeconds;
+  pPlan->PreRangeTimeOutMClks = 0;
+
+  Status = VL53L0X_GetSequenceStepEnables(Dev, &SchedulerSequenceSteps);
+
+  if (Status == VL53L0X_ERROR_NONE &&
+      (SchedulerSequenceSteps.TccOn || SchedulerSequenceSteps.MsrcOn ||
+       SchedulerSequenceSteps.DssOn))
+    Status = get_sequence_step_timeout(Dev, VL53L0X_SEQUENCESTEP_MSRC,
+                                       &MsrcDccTccTimeoutMicroSeconds);
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    if (SchedulerSequenceSteps.TccOn)
+      pPlan->OverheadMicroSeconds +=
+          MsrcDccTccTimeoutMicroSeconds + TccOverheadMicroSeconds;
+
+    if (SchedulerSequenceSteps.DssOn)
+      pPlan->OverheadMicroSeconds +=
+          2 * (MsrcDccTccTimeoutMicroSeconds + DssOverheadMicroSeconds);
+    else if (SchedulerSequenceSteps.MsrcOn)
+      pPlan->OverheadMicroSeconds +=
+          MsrcDccTccTimeoutMicroSeconds + MsrcOverheadMicroSeconds;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE && SchedulerSequenceSteps.PreRangeOn) {
+    Status = get_sequence_step_timeout(Dev, VL53L0X_SEQUENCESTEP_PRE_RANGE,
+                                       &PreRangeTimeoutMicroSeconds);
+    pPlan->OverheadMicroSeconds +=
+        PreRangeTimeoutMicroSeconds + PreRangeOverheadMicroSeconds;
+
+    /* The final range timeout register counts the pre-range too */
+    if (Status == VL53L0X_ERROR_NONE)
+      Status =
+          VL53L0X_RdWord(Dev, VL53L0X_REG_PRE_RANGE_CONFIG_TIMEOUT_MACROP_HI,
+                         &PreRangeEncodedTimeOut);
+    if (Status == VL53L0X_ERROR_NONE)
+      pPlan->PreRangeTimeOutMClks =
+          (uint16_t)VL53L0X_decode_timeout(PreRangeEncodedTimeOut);
+  }
+
+  if (Status == VL53L0X_ERROR_NONE)
+    Status = VL53L0X_GetVcselPulsePeriod(Dev, VL53L0X_VCSEL_PERIOD_FINAL_RANGE,
+                                         &pPlan->FinalRangeVcselPulsePeriod);
+
+  pPlan->FinalRangeOn = SchedulerSequenceSteps.FinalRangeOn;
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error
+VL53L0X_set_budget_from_plan(VL53L0X_DEV Dev, const VL53L0X_BudgetPlan_t *pPlan,
+                             uint32_t MeasurementTimingBudgetMicroSeconds) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint32_t FinalRangeOverheadMicroSeconds = 550;
+  uint32_t cMinTimingBudgetMicroSeconds = 20000;
+  uint32_t FinalRangeTimeOutMicroSeconds;
+  uint32_t FinalRangeTimeOutMClks;
+
+  LOG_FUNCTION_START("");
+
+  if ((MeasurementTimingBudgetMicroSeconds < cMinTimingBudgetMicroSeconds) ||
+      (MeasurementTimingBudgetMicroSeconds <=
+       pPlan->OverheadMicroSeconds + FinalRangeOverheadMicroSeconds)) {
+    Status = VL53L0X_ERROR_INVALID_PARAMS;
+    LOG_FUNCTION_END(Status);
+    return Status;
+  }
+
+  if (pPlan->FinalRangeOn) {
+    FinalRangeTimeOutMicroSeconds = MeasurementTimingBudgetMicroSeconds -
+                                    pPlan->OverheadMicroSeconds -
+                                    FinalRangeOverheadMicroSeconds;
+
+    FinalRangeTimeOutMClks = VL53L0X_calc_timeout_mclks(
+        Dev, FinalRangeTimeOutMicroSeconds, pPlan->FinalRangeVcselPulsePeriod);
+    FinalRangeTimeOutMClks += pPlan->PreRangeTimeOutMClks;
+
+    Status =
+        VL53L0X_WrWord(Dev, VL53L0X_REG_FINAL_RANGE_CONFIG_TIMEOUT_MACROP_HI,
+                       VL53L0X_encode_timeout(FinalRangeTimeOutMClks));
+
+    if (Status == VL53L0X_ERROR_NONE) {
+      VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs,
+                                         FinalRangeTimeOutMicroSeconds);
+      VL53L0X_SETPARAMETERFIELD(Dev, MeasurementTimingBudgetMicroSeconds,
+                                MeasurementTimingBudgetMicroSeconds);
+    }
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
 VL53L0X_Error VL53L0X_get_measurement_timing_budget_micro_seconds(
     VL53L0X_DEV Dev, uint32_t *pMeasurementTimingBudgetMicroSeconds) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
@@ -1173,9 +1659,20 @@ VL53L0X_Error VL53L0X_get_measurement_timing_budget_micro_seconds(
 
 VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
                                            uint8_t *pTuningSettingBuffer) {
+  uint16_t Index = 0;
+
+  return VL53L0X_load_tuning_settings_part(Dev, pTuningSettingBuffer, &Index,
+                                           0);
+}
+
+VL53L0X_Error VL53L0X_load_tuning_settings_part(VL53L0X_DEV Dev,
+                                                uint8_t *pTuningSettingBuffer,
+                                                uint16_t *pIndex,
+                                                uint16_t MaxWrites) {
   VL53L0X_Error Status = VL53L0X_ERROR_NONE;
   int i;
-  int Index;
+  uint16_t Index;
+  uint16_t Writes = 0;
   uint8_t msb;
   uint8_t lsb;
   uint8_t SelectParam;
@@ -1186,9 +1683,11 @@ VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
 
   LOG_FUNCTION_START("");
 
-  Index = 0;
+  Index = *pIndex;
 
+  /* MaxWrites 0 loads the rest of the buffer in one go */
   while ((*(pTuningSettingBuffer + Index) != 0) &&
+         ((MaxWrites == 0) || (Writes < MaxWrites)) &&
          (Status == VL53L0X_ERROR_NONE)) {
     NumberOfWrites = *(pTuningSettingBuffer + Index);
     Index++;
@@ -1243,12 +1742,15 @@ VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
       }
 
       Status = VL53L0X_WriteMulti(Dev, Address, localBuffer, NumberOfWrites);
+      Writes++;
 
     } else {
       Status = VL53L0X_ERROR_INVALID_PARAMS;
     }
   }
 
+  *pIndex = Index;
+
   LOG_FUNCTION_END(Status);
   return Status;
 }
@@ -1828,7 +2330,6 @@ VL53L0X_Error VL53L0X_get_pal_range_status(
   FixPoint1616_t RangeIgnoreThresholdValue;
   FixPoint1616_t SignalRatePerSpad;
   uint8_t DeviceRangeStatusInternal = 0;
-  uint16_t tmpWord = 0;
   uint8_t Temp8;
   uint32_t Dmax_mm = 0;
   FixPoint1616_t LastSignalRefMcps;
@@ -1854,20 +2355,8 @@ VL53L0X_Error VL53L0X_get_pal_range_status(
     NoneFlag = 0;
   }
 
-  /* LastSignalRefMcps */
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x01);
-
-  if (Status == VL53L0X_ERROR_NONE)
-    Status =
-        VL53L0X_RdWord(Dev, VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF, &tmpWord);
-
-  LastSignalRefMcps = VL53L0X_FIXPOINT97TOFIXPOINT1616(tmpWord);
-
-  if (Status == VL53L0X_ERROR_NONE)
-    Status = VL53L0X_WrByte(Dev, 0xFF, 0x00);
-
-  PALDevDataSet(Dev, LastSignalRefMcps, LastSignalRefMcps);
+  /* LastSignalRefMcps, read along with the result block */
+  LastSignalRefMcps = PALDevDataGet(Dev, LastSignalRefMcps);
 
   /*
    * Check if Sigma limit is enabled, if yes then do comparison with limit
@@ -2021,3 +2510,344 @@ VL53L0X_Error VL53L0X_get_pal_range_status(
   LOG_FUNCTION_END(Status);
   return Status;
 }
+
+VL53L0X_Error VL53L0X_read_raw_result(VL53L0X_DEV Dev,
+                                      VL53L0X_RawResult_t *pRawResult) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+
+  LOG_FUNCTION_START("");
+
+  Status = VL53L0X_consume_raw_result(Dev, pRawResult, 0, 0, NULL);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_consume_raw_result(VL53L0X_DEV Dev,
+                                         VL53L0X_RawResult_t *pRawResult,
+                                         uint8_t ClearInterrupt,
+                                         uint8_t StartMode,
+                                         uint8_t *pInterruptStatus) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegBatch_t Batch;
+  uint8_t SignalRef[2];
+
+  LOG_FUNCTION_START("");
+
+  /*
+   * use multi read even if some registers are not useful, result will
+   * be more efficient
+   * start reading at 0x14 dec20
+   * end reading at 0x1F dec31 total 12 bytes to read
+   */
+  VL53L0X_batch_init(&Batch);
+  VL53L0X_batch_read(&Batch, VL53L0X_REG_RESULT_RANGE_STATUS,
+                     pRawResult->ResultBlock, VL53L0X_RESULT_BLOCK_SIZE);
+
+  /* LastSignalRefMcps */
+  VL53L0X_batch_write(&Batch, 0xFF, 0x01);
+  VL53L0X_batch_read(&Batch, VL53L0X_REG_RESULT_PEAK_SIGNAL_RATE_REF,
+                     SignalRef, 2);
+  VL53L0X_batch_write(&Batch, 0xFF, 0x00);
+
+  /* Same clear as VL53L0X_ClearInterruptMask, read back only if asked */
+  if (ClearInterrupt) {
+    VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x01);
+    VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSTEM_INTERRUPT_CLEAR, 0x00);
+    if (pInterruptStatus != NULL)
+      VL53L0X_batch_read(&Batch, VL53L0X_REG_RESULT_INTERRUPT_STATUS,
+                         pInterruptStatus, 1);
+  }
+
+  /* The next range only starts once this one has been read */
+  if (StartMode != 0)
+    VL53L0X_batch_write(&Batch, VL53L0X_REG_SYSRANGE_START, StartMode);
+
+  Status = VL53L0X_batch_submit(Dev, &Batch);
+
+  if (Status == VL53L0X_ERROR_NONE)
+    pRawResult->SignalRefRaw = VL53L0X_MAKEUINT16(SignalRef[1], SignalRef[0]);
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_decode_ranging_result(
+    VL53L0X_DEV Dev, const VL53L0X_RawResult_t *pRawResult,
+    VL53L0X_RangingMeasurementData_t *pRangingMeasurementData) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  uint8_t DeviceRangeStatus;
+  uint8_t RangeFractionalEnable;
+  uint8_t PalRangeStatus;
+  uint8_t XTalkCompensationEnable;
+  uint16_t AmbientRate;
+  FixPoint1616_t SignalRate;
+  uint16_t XTalkCompensationRateMegaCps;
+  uint16_t EffectiveSpadRtnCount;
+  uint16_t tmpuint16;
+  uint16_t XtalkRangeMilliMeter;
+  uint16_t LinearityCorrectiveGain;
+  const uint8_t *localBuffer = pRawResult->ResultBlock;
+  VL53L0X_RangingMeasurementData_t LastRangeDataBuffer;
+
+  LOG_FUNCTION_START("");
+
+  PALDevDataSet(Dev, LastSignalRefMcps,
+                VL53L0X_FIXPOINT97TOFIXPOINT1616(pRawResult->SignalRefRaw));
+
+  if (Status == VL53L0X_ERROR_NONE) {
+
+    pRangingMeasurementData->ZoneId = 0;    /* Only one zone */
+    pRangingMeasurementData->TimeStamp = 0; /* Not Implemented */
+
+    tmpuint16 = VL53L0X_MAKEUINT16(localBuffer[11], localBuffer[10]);
+    /* cut1.1 if SYSTEM__RANGE_CONFIG if 1 range is 2bits fractional
+     *(format 11.2) else no fractional
+     */
+
+    pRangingMeasurementData->MeasurementTimeUsec = 0;
+
+    SignalRate = VL53L0X_FIXPOINT97TOFIXPOINT1616(
+        VL53L0X_MAKEUINT16(localBuffer[7], localBuffer[6]));
+    /* peak_signal_count_rate_rtn_mcps */
+    pRangingMeasurementData->SignalRateRtnMegaCps = SignalRate;
+
+    AmbientRate = VL53L0X_MAKEUINT16(localBuffer[9], localBuffer[8]);
+    pRangingMeasurementData->AmbientRateRtnMegaCps =
+        VL53L0X_FIXPOINT97TOFIXPOINT1616(AmbientRate);
+
+    EffectiveSpadRtnCount = VL53L0X_MAKEUINT16(localBuffer[3], localBuffer[2]);
+    /* EffectiveSpadRtnCount is 8.8 format */
+    pRangingMeasurementData->EffectiveSpadRtnCount = EffectiveSpadRtnCount;
+
+    DeviceRangeStatus = localBuffer[0];
+
+    /* Get Linearity Corrective Gain */
+    LinearityCorrectiveGain = PALDevDataGet(Dev, LinearityCorrectiveGain);
+
+    /* Get ranging configuration */
+    RangeFractionalEnable = PALDevDataGet(Dev, RangeFractionalEnable);
+
+    if (LinearityCorrectiveGain != 1000) {
+
+      tmpuint16 =
+          (uint16_t)((LinearityCorrectiveGain * tmpuint16 + 500) / 1000);
+
+      /* Implement Xtalk */
+      VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps,
+                                XTalkCompensationRateMegaCps);
+      VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationEnable,
+                                XTalkCompensationEnable);
+
+      if (XTalkCompensationEnable) {
+
+        if ((SignalRate -
+             ((XTalkCompensationRateMegaCps * EffectiveSpadRtnCount) >> 8)) <=
+            0) {
+          if (RangeFractionalEnable)
+            XtalkRangeMilliMeter = 8888;
+          else
+            XtalkRangeMilliMeter = 8888 << 2;
+        } else {
+          XtalkRangeMilliMeter =
+              (tmpuint16 * SignalRate) /
+              (SignalRate -
+               ((XTalkCompensationRateMegaCps * EffectiveSpadRtnCount) >> 8));
+        }
+
+        tmpuint16 = XtalkRangeMilliMeter;
+      }
+    }
+
+    if (RangeFractionalEnable) {
+      pRangingMeasurementData->RangeMilliMeter = (uint16_t)((tmpuint16) >> 2);
+      pRangingMeasurementData->RangeFractionalPart =
+          (uint8_t)((tmpuint16 & 0x03) << 6);
+    } else {
+      pRangingMeasurementData->RangeMilliMeter = tmpuint16;
+      pRangingMeasurementData->RangeFractionalPart = 0;
+    }
+
+    /*
+     * For a standard definition of RangeStatus, this should
+     * return 0 in case of good result after a ranging
+     * The range status depends on the device so call a device
+     * specific function to obtain the right Status.
+     */
+    Status |= VL53L0X_get_pal_range_status(
+        Dev, DeviceRangeStatus, SignalRate, EffectiveSpadRtnCount,
+        pRangingMeasurementData, &PalRangeStatus);
+
+    if (Status == VL53L0X_ERROR_NONE)
+      pRangingMeasurementData->RangeStatus = PalRangeStatus;
+  }
+
+  if (Status == VL53L0X_ERROR_NONE) {
+    /* Copy last read data into Dev buffer */
+    LastRangeDataBuffer = PALDevDataGet(Dev, LastRangeMeasure);
+
+    LastRangeDataBuffer.RangeMilliMeter =
+        pRangingMeasurementData->RangeMilliMeter;
+    LastRangeDataBuffer.RangeFractionalPart =
+        pRangingMeasurementData->RangeFractionalPart;
+    LastRangeDataBuffer.RangeDMaxMilliMeter =
+        pRangingMeasurementData->RangeDMaxMilliMeter;
+    LastRangeDataBuffer.MeasurementTimeUsec =
+        pRangingMeasurementData->MeasurementTimeUsec;
+    LastRangeDataBuffer.SignalRateRtnMegaCps =
+        pRangingMeasurementData->SignalRateRtnMegaCps;
+    LastRangeDataBuffer.AmbientRateRtnMegaCps =
+        pRangingMeasurementData->AmbientRateRtnMegaCps;
+    LastRangeDataBuffer.EffectiveSpadRtnCount =
+        pRangingMeasurementData->EffectiveSpadRtnCount;
+    LastRangeDataBuffer.RangeStatus = pRangingMeasurementData->RangeStatus;
+
+    PALDevDataSet(Dev, LastRangeMeasure, LastRangeDataBuffer);
+  }
+
+  LOG_FUNCTION_END(Status);
+  return Status;
+}
+
+VL53L0X_Error VL53L0X_get_decode_config(VL53L0X_DEV Dev,
+                                        VL53L0X_DecodeConfig_t *pConfig) {
+  uint8_t i;
+
+  pConfig->LinearityCorrectiveGain =
+      PALDevDataGet(Dev, LinearityCorrectiveGain);
+  pConfig->RangeFractionalEnable = PALDevDataGet(Dev, RangeFractionalEnable);
+  VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationEnable,
+                            pConfig->XTalkCompensationEnable);
+  VL53L0X_GETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps,
+                            pConfig->XTalkCompensationRateMegaCps);
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
+    VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, i,
+                                   pConfig->LimitChecksEnable[i]);
+    VL53L0X_GETARRAYPARAMETERFIELD(Dev, LimitChecksValue, i,
+                                   pConfig->LimitChecksValue[i]);
+  }
+  pConfig->FinalRangeTimeoutMicroSecs =
+      VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs);
+  pConfig->PreRangeTimeoutMicroSecs =
+      VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs);
+  pConfig->FinalRangeVcselPulsePeriod =
+      VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod);
+  pConfig->PreRangeVcselPulsePeriod =
+      VL53L0X_GETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod);
+  pConfig->DmaxCalRangeMilliMeter = PALDevDataGet(Dev, DmaxCalRangeMilliMeter);
+  pConfig->DmaxCalSignalRateRtnMegaCps =
+      PALDevDataGet(Dev, DmaxCalSignalRateRtnMegaCps);
+
+  return VL53L0X_ERROR_NONE;
+}
+
+VL53L0X_Error VL53L0X_set_decode_config(VL53L0X_DEV Dev,
+                                        const VL53L0X_DecodeConfig_t *pConfig) {
+  uint8_t i;
+
+  PALDevDataSet(Dev, LinearityCorrectiveGain, pConfig->LinearityCorrectiveGain);
+  PALDevDataSet(Dev, RangeFractionalEnable, pConfig->RangeFractionalEnable);
+  VL53L0X_SETPARAMETERFIELD(Dev, XTalkCompensationEnable,
+                            pConfig->XTalkCompensationEnable);
+  VL53L0X_SETPARAMETERFIELD(Dev, XTalkCompensationRateMegaCps,
+                            pConfig->XTalkCompensationRateMegaCps);
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++) {
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksEnable, i,
+                                   pConfig->LimitChecksEnable[i]);
+    VL53L0X_SETARRAYPARAMETERFIELD(Dev, LimitChecksValue, i,
+                                   pConfig->LimitChecksValue[i]);
+  }
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeTimeoutMicroSecs,
+                                     pConfig->FinalRangeTimeoutMicroSecs);
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeTimeoutMicroSecs,
+                                     pConfig->PreRangeTimeoutMicroSecs);
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, FinalRangeVcselPulsePeriod,
+                                     pConfig->FinalRangeVcselPulsePeriod);
+  VL53L0X_SETDEVICESPECIFICPARAMETER(Dev, PreRangeVcselPulsePeriod,
+                                     pConfig->PreRangeVcselPulsePeriod);
+  PALDevDataSet(Dev, DmaxCalRangeMilliMeter, pConfig->DmaxCalRangeMilliMeter);
+  PALDevDataSet(Dev, DmaxCalSignalRateRtnMegaCps,
+                pConfig->DmaxCalSignalRateRtnMegaCps);
+
+  return VL53L0X_ERROR_NONE;
+}
+
+/* Big endian, field by field, so captures do not depend on the padding and
+ * byte order of the machine that took them */
+static uint8_t *pack_uint(uint8_t *pBuffer, uint32_t value, uint8_t size) {
+  while (size--)
+    *pBuffer++ = (uint8_t)(value >> (8 * size));
+  return pBuffer;
+}
+
+static const uint8_t *unpack_uint(const uint8_t *pBuffer, uint32_t *pValue,
+                                  uint8_t size) {
+  *pValue = 0;
+  while (size--)
+    *pValue = (*pValue << 8) | *pBuffer++;
+  return pBuffer;
+}
+
+void VL53L0X_pack_raw_result(const VL53L0X_RawResult_t *pRawResult,
+                             uint8_t *pBuffer) {
+  memcpy(pBuffer, pRawResult->ResultBlock, VL53L0X_RESULT_BLOCK_SIZE);
+  pack_uint(pBuffer + VL53L0X_RESULT_BLOCK_SIZE, pRawResult->SignalRefRaw, 2);
+}
+
+void VL53L0X_unpack_raw_result(const uint8_t *pBuffer,
+                               VL53L0X_RawResult_t *pRawResult) {
+  uint32_t Value;
+
+  memcpy(pRawResult->ResultBlock, pBuffer, VL53L0X_RESULT_BLOCK_SIZE);
+  unpack_uint(pBuffer + VL53L0X_RESULT_BLOCK_SIZE, &Value, 2);
+  pRawResult->SignalRefRaw = (uint16_t)Value;
+}
+
+void VL53L0X_pack_decode_config(const VL53L0X_DecodeConfig_t *pConfig,
+                                uint8_t *pBuffer) {
+  uint8_t i;
+
+  *pBuffer++ = VL53L0X_DECODE_CONFIG_VERSION;
+  pBuffer = pack_uint(pBuffer, pConfig->LinearityCorrectiveGain, 2);
+  *pBuffer++ = pConfig->RangeFractionalEnable;
+  *pBuffer++ = pConfig->XTalkCompensationEnable;
+  pBuffer = pack_uint(pBuffer, pConfig->XTalkCompensationRateMegaCps, 4);
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++)
+    *pBuffer++ = pConfig->LimitChecksEnable[i];
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++)
+    pBuffer = pack_uint(pBuffer, pConfig->LimitChecksValue[i], 4);
+  pBuffer = pack_uint(pBuffer, pConfig->FinalRangeTimeoutMicroSecs, 4);
+  pBuffer = pack_uint(pBuffer, pConfig->PreRangeTimeoutMicroSecs, 4);
+  *pBuffer++ = pConfig->FinalRangeVcselPulsePeriod;
+  *pBuffer++ = pConfig->PreRangeVcselPulsePeriod;
+  pBuffer = pack_uint(pBuffer, pConfig->DmaxCalRangeMilliMeter, 2);
+  pack_uint(pBuffer, pConfig->DmaxCalSignalRateRtnMegaCps, 4);
+}
+
+VL53L0X_Error VL53L0X_unpack_decode_config(const uint8_t *pBuffer,
+                                           VL53L0X_DecodeConfig_t *pConfig) {
+  uint32_t Value;
+  uint8_t i;
+
+  if (*pBuffer++ != VL53L0X_DECODE_CONFIG_VERSION)
+    return VL53L0X_ERROR_NOT_SUPPORTED;
+
+  pBuffer = unpack_uint(pBuffer, &Value, 2);
+  pConfig->LinearityCorrectiveGain = (uint16_t)Value;
+  pConfig->RangeFractionalEnable = *pBuffer++;
+  pConfig->XTalkCompensationEnable = *pBuffer++;
+  pBuffer = unpack_uint(pBuffer, &pConfig->XTalkCompensationRateMegaCps, 4);
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++)
+    pConfig->LimitChecksEnable[i] = *pBuffer++;
+  for (i = 0; i < VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS; i++)
+    pBuffer = unpack_uint(pBuffer, &pConfig->LimitChecksValue[i], 4);
+  pBuffer = unpack_uint(pBuffer, &pConfig->FinalRangeTimeoutMicroSecs, 4);
+  pBuffer = unpack_uint(pBuffer, &pConfig->PreRangeTimeoutMicroSecs, 4);
+  pConfig->FinalRangeVcselPulsePeriod = *pBuffer++;
+  pConfig->PreRangeVcselPulsePeriod = *pBuffer++;
+  pBuffer = unpack_uint(pBuffer, &Value, 2);
+  pConfig->DmaxCalRangeMilliMeter = (uint16_t)Value;
+  unpack_uint(pBuffer, &pConfig->DmaxCalSignalRateRtnMegaCps, 4);
+
+  return VL53L0X_ERROR_NONE;
+}
@@ -3,13 +3,62 @@
 
 //#define I2C_DEBUG
 
+#ifdef VL53L0X_I2C_TRACE
+static VL53L0X_I2cTraceRecord_t trace_ring[VL53L0X_I2C_TRACE_SIZE];
+static uint32_t trace_total = 0;
+
+static void trace_record(uint32_t start, uint8_t deviceAddress, uint8_t op,
+                         uint8_t index, const uint8_t *pdata, uint32_t count,
+                         uint8_t status) {
+  VL53L0X_I2cTraceRecord_t *pRecord =
+      &trace_ring[trace_total % VL53L0X_I2C_TRACE_SIZE];
+  uint32_t duration = micros() - start;
+  uint8_t i;
+
+  pRecord->micros = start;
+  pRecord->duration = (duration > 0xffff) ? 0xffff : duration;
+  pRecord->address = deviceAddress;
+  pRecord->op = op;
+  pRecord->index = index;
+  pRecord->length = (count > 0xff) ? 0xff : count;
+  pRecord->status = status;
+  for (i = 0; i < VL53L0X_I2C_TRACE_DATA; i++)
+    pRecord->data[i] = (i < count) ? pdata[i] : 0;
+  trace_total++;
+}
+
+void VL53L0X_i2c_trace_reset(void) { trace_total = 0; }
+
+uint32_t VL53L0X_i2c_trace_total(void) { return trace_total; }
+
+uint16_t VL53L0X_i2c_trace_count(void) {
+  return (trace_total < VL53L0X_I2C_TRACE_SIZE) ? trace_total
+                                                : VL53L0X_I2C_TRACE_SIZE;
+}
+
+// index 0 is the oldest transaction still in the ring
+const VL53L0X_I2cTraceRecord_t *VL53L0X_i2c_trace_get(uint16_t index) {
+  if (index >= VL53L0X_i2c_trace_count())
+    return NULL;
+  return &trace_ring[(trace_total - VL53L0X_i2c_trace_count() + index) %
+                     VL53L0X_I2C_TRACE_SIZE];
+}
+#endif
+
 int VL53L0X_i2c_init(TwoWire *i2c) {
   i2c->begin();
   return VL53L0X_ERROR_NONE;
 }
 
-int VL53L0X_write_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
-                        uint32_t count, TwoWire *i2c) {
+int VL53L0X_write_chain(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                        uint32_t count, TwoWire *i2c, uint8_t stop) {
+#ifdef VL53L0X_I2C_TRACE
+  uint32_t start = micros();
+  uint8_t *ptrace = pdata;
+  uint32_t ntrace = count;
+#endif
+  uint8_t status;
+
   i2c->beginTransmission(deviceAddress);
   i2c->write(index);
 #ifdef I2C_DEBUG
@@ -31,16 +80,29 @@ int VL53L0X_write_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
 #ifdef I2C_DEBUG
   Serial.println();
 #endif
-  i2c->endTransmission();
-  return VL53L0X_ERROR_NONE;
+  status = i2c->endTransmission(stop != 0);
+#ifdef VL53L0X_I2C_TRACE
+  trace_record(start, deviceAddress, VL53L0X_I2C_TRACE_WRITE, index, ptrace,
+               ntrace, status);
+#endif
+  return status;
 }
 
-int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
-                       uint32_t count, TwoWire *i2c) {
+int VL53L0X_read_chain(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                       uint32_t count, TwoWire *i2c, uint8_t stop) {
+#ifdef VL53L0X_I2C_TRACE
+  uint32_t start = micros();
+  uint8_t *ptrace = pdata;
+  uint32_t ntrace = count;
+#endif
+  uint8_t status;
+
   i2c->beginTransmission(deviceAddress);
   i2c->write(index);
-  i2c->endTransmission();
-  i2c->requestFrom(deviceAddress, (byte)count);
+  status = i2c->endTransmission(stop != 0);
+  if (i2c->requestFrom(deviceAddress, (uint8_t)count, (uint8_t)(stop != 0)) !=
+      count)
+    status |= VL53L0X_I2C_STATUS_SHORT;
 #ifdef I2C_DEBUG
   Serial.print("\tReading ");
   Serial.print(count);
@@ -61,7 +123,21 @@ int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
 #ifdef I2C_DEBUG
   Serial.println();
 #endif
-  return VL53L0X_ERROR_NONE;
+#ifdef VL53L0X_I2C_TRACE
+  trace_record(start, deviceAddress, VL53L0X_I2C_TRACE_READ, index, ptrace,
+               ntrace, status);
+#endif
+  return status;
+}
+
+int VL53L0X_write_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                        uint32_t count, TwoWire *i2c) {
+  return VL53L0X_write_chain(deviceAddress, index, pdata, count, i2c, 1);
+}
+
+int VL53L0X_read_multi(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                       uint32_t count, TwoWire *i2c) {
+  return VL53L0X_read_chain(deviceAddress, index, pdata, count, i2c, 1);
 }
 
 int VL53L0X_write_byte(uint8_t deviceAddress, uint8_t index, uint8_t data,
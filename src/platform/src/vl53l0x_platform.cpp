@@ -269,6 +269,149 @@ VL53L0X_Error VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data) {
   return Status;
 }
 
+static VL53L0X_RegOp_t *batch_add(VL53L0X_RegBatch_t *pBatch, uint8_t op,
+                                  uint8_t index) {
+  VL53L0X_RegOp_t *pOp;
+
+  if (pBatch->Count >= VL53L0X_REG_BATCH_SIZE) {
+    pBatch->Overflow = 1;
+    return NULL;
+  }
+
+  pOp = &pBatch->Ops[pBatch->Count++];
+  pOp->Op = op;
+  pOp->Index = index;
+  pOp->Data = 0;
+  pOp->Mask = 0xFF;
+  pOp->Length = 0;
+  pOp->pData = NULL;
+  pOp->Status = VL53L0X_ERROR_UNDEFINED;
+  return pOp;
+}
+
+void VL53L0X_batch_init(VL53L0X_RegBatch_t *pBatch) {
+  pBatch->Count = 0;
+  pBatch->Overflow = 0;
+}
+
+void VL53L0X_batch_write(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                         uint8_t data) {
+  VL53L0X_RegOp_t *pOp = batch_add(pBatch, VL53L0X_REGOP_WRITE, index);
+
+  if (pOp != NULL)
+    pOp->Data = data;
+}
+
+void VL53L0X_batch_read(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                        uint8_t *pdata, uint8_t count) {
+  VL53L0X_RegOp_t *pOp = batch_add(pBatch, VL53L0X_REGOP_READ, index);
+
+  if (pOp != NULL) {
+    pOp->pData = pdata;
+    pOp->Length = count;
+  }
+}
+
+void VL53L0X_batch_update(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                          uint8_t AndData, uint8_t OrData) {
+  VL53L0X_RegOp_t *pOp = batch_add(pBatch, VL53L0X_REGOP_UPDATE, index);
+
+  if (pOp != NULL) {
+    pOp->Mask = AndData;
+    pOp->Data = OrData;
+  }
+}
+
+void VL53L0X_batch_poll(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                        uint8_t mask, uint8_t value) {
+  VL53L0X_RegOp_t *pOp = batch_add(pBatch, VL53L0X_REGOP_POLL, index);
+
+  if (pOp != NULL) {
+    pOp->Mask = mask;
+    pOp->Data = value;
+  }
+}
+
+VL53L0X_Error VL53L0X_batch_submit(VL53L0X_DEV Dev,
+                                   VL53L0X_RegBatch_t *pBatch) {
+  VL53L0X_Error Status = VL53L0X_ERROR_NONE;
+  VL53L0X_RegOp_t *pOp;
+  uint8_t buffer[VL53L0X_REG_BATCH_SIZE];
+  uint8_t deviceAddress = Dev->I2cDevAddr;
+  uint8_t i = 0;
+  uint8_t n;
+  uint8_t stop;
+  uint8_t data;
+  uint32_t LoopNb;
+  int32_t status_int;
+
+  if (pBatch->Overflow)
+    return VL53L0X_ERROR_BUFFER_TOO_SMALL;
+
+  for (n = 0; n < pBatch->Count; n++)
+    pBatch->Ops[n].Status = VL53L0X_ERROR_UNDEFINED;
+
+  while ((Status == VL53L0X_ERROR_NONE) && (i < pBatch->Count)) {
+    pOp = &pBatch->Ops[i];
+    n = 1;
+
+    /* Consecutive registers are written in one go, the page select at 0xFF
+     * never is part of a run */
+    if (pOp->Op == VL53L0X_REGOP_WRITE) {
+      buffer[0] = pOp->Data;
+      while ((i + n < pBatch->Count) &&
+             (pBatch->Ops[i + n].Op == VL53L0X_REGOP_WRITE) &&
+             ((uint16_t)pOp->Index + n < 0xFF) &&
+             (pBatch->Ops[i + n].Index == pOp->Index + n)) {
+        buffer[n] = pBatch->Ops[i + n].Data;
+        n++;
+      }
+    }
+
+    stop = !VL53L0X_I2C_REPEATED_START || (i + n >= pBatch->Count) ||
+           (pBatch->Ops[i + n].Op == VL53L0X_REGOP_POLL);
+
+    switch (pOp->Op) {
+    case VL53L0X_REGOP_WRITE:
+      status_int = VL53L0X_write_chain(deviceAddress, pOp->Index, buffer, n,
+                                       Dev->i2c, stop);
+      break;
+    case VL53L0X_REGOP_READ:
+      status_int = VL53L0X_read_chain(deviceAddress, pOp->Index, pOp->pData,
+                                      pOp->Length, Dev->i2c, stop);
+      break;
+    case VL53L0X_REGOP_UPDATE:
+      status_int = VL53L0X_read_chain(deviceAddress, pOp->Index, &data, 1,
+                                      Dev->i2c, !VL53L0X_I2C_REPEATED_START);
+      if (status_int == 0) {
+        data = (data & pOp->Mask) | pOp->Data;
+        status_int = VL53L0X_write_chain(deviceAddress, pOp->Index, &data, 1,
+                                         Dev->i2c, stop);
+      }
+      break;
+    default:
+      LoopNb = 0;
+      do {
+        status_int = VL53L0X_read_chain(deviceAddress, pOp->Index, &data, 1,
+                                        Dev->i2c, 1);
+        LoopNb++;
+      } while ((status_int == 0) && ((data & pOp->Mask) != pOp->Data) &&
+               (LoopNb < VL53L0X_DEFAULT_MAX_LOOP));
+      if ((status_int == 0) && ((data & pOp->Mask) != pOp->Data))
+        Status = VL53L0X_ERROR_TIME_OUT;
+      break;
+    }
+
+    if (status_int != 0)
+      Status = VL53L0X_ERROR_CONTROL_INTERFACE;
+
+    while (n--)
+      pBatch->Ops[i++].Status = Status;
+  }
+
+  return Status;
+}
+
 #define VL53L0X_POLLINGDELAY_LOOPNB 250
 VL53L0X_Error VL53L0X_PollingDelay(VL53L0X_DEV Dev) {
   VL53L0X_Error status = VL53L0X_ERROR_NONE;
@@ -283,3 +426,8 @@ VL53L0X_Error VL53L0X_PollingDelay(VL53L0X_DEV Dev) {
   LOG_FUNCTION_END(status);
   return status;
 }
+
+VL53L0X_Error VL53L0X_GetTickCount(uint32_t *pTickCountMs) {
+  *pTickCountMs = millis();
+  return VL53L0X_ERROR_NONE;
+}
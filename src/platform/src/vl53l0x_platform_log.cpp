@@ -0,0 +1,115 @@
+/**
+ * @file vl53l0x_platform_log.cpp
+ *
+ * @brief Latency recording behind the PAL LOG_FUNCTION_START/END hooks
+ *
+ * With VL53L0X_LATENCY_ENABLE the hooks pass __FUNCTION__ here instead of
+ * formatting a trace. A function is identified by the address of its name,
+ * so recording a call is a few pointer compares and two micros() reads.
+ * Times include the callees and the recording overhead of their hooks.
+ */
+#include "../../vl53l0x_platform.h"
+
+#if !defined(VL53L0X_LOG_ENABLE) && defined(VL53L0X_LATENCY_ENABLE)
+
+#include <Arduino.h>
+
+/** @brief A PAL call that has started and not ended yet */
+typedef struct {
+  const char *Function; /*!< __FUNCTION__ of the PAL function */
+  uint32_t Start;       /*!< micros() at LOG_FUNCTION_START */
+} VL53L0X_LatencyFrame_t;
+
+static VL53L0X_LatencyEntry_t latency_table[VL53L0X_LATENCY_TABLE_SIZE];
+static uint8_t latency_count = 0;
+static uint32_t latency_dropped = 0;
+
+static VL53L0X_LatencyFrame_t latency_stack[VL53L0X_LATENCY_STACK_DEPTH];
+static uint8_t latency_depth = 0;
+
+void VL53L0X_latency_start(const char *function) {
+  uint8_t level;
+
+  /* The PAL does not recurse, so if the function is already on the stack it
+   * returned early without its LOG_FUNCTION_END last time. Forget that call
+   * and everything it left behind. */
+  for (level = 0; level < latency_depth; level++) {
+    if (latency_stack[level].Function == function) {
+      latency_depth = level;
+      break;
+    }
+  }
+
+  if (latency_depth >= VL53L0X_LATENCY_STACK_DEPTH) {
+    latency_dropped++;
+    return;
+  }
+
+  latency_stack[latency_depth].Function = function;
+  latency_stack[latency_depth].Start = micros();
+  latency_depth++;
+}
+
+void VL53L0X_latency_end(const char *function) {
+  uint32_t now = micros();
+  uint32_t elapsed;
+  VL53L0X_LatencyEntry_t *pEntry = NULL;
+  uint8_t level;
+  uint8_t i;
+
+  /* Unwind to the matching start, callees that returned early go with it */
+  for (level = latency_depth; level > 0; level--) {
+    if (latency_stack[level - 1].Function == function)
+      break;
+  }
+  if (level == 0)
+    return; /* the start was not recorded */
+
+  latency_depth = level - 1;
+  elapsed = now - latency_stack[latency_depth].Start;
+
+  for (i = 0; i < latency_count; i++) {
+    if (latency_table[i].Function == function) {
+      pEntry = &latency_table[i];
+      break;
+    }
+  }
+
+  if (pEntry == NULL) {
+    if (latency_count >= VL53L0X_LATENCY_TABLE_SIZE) {
+      latency_dropped++;
+      return;
+    }
+    pEntry = &latency_table[latency_count++];
+    pEntry->Function = function;
+    pEntry->Calls = 0;
+    pEntry->TotalMicroSeconds = 0;
+    pEntry->MinMicroSeconds = 0xffffffff;
+    pEntry->MaxMicroSeconds = 0;
+  }
+
+  pEntry->Calls++;
+  pEntry->TotalMicroSeconds += elapsed;
+  if (elapsed < pEntry->MinMicroSeconds)
+    pEntry->MinMicroSeconds = elapsed;
+  if (elapsed > pEntry->MaxMicroSeconds)
+    pEntry->MaxMicroSeconds = elapsed;
+}
+
+void VL53L0X_latency_reset(void) {
+  latency_count = 0;
+  latency_dropped = 0;
+  latency_depth = 0;
+}
+
+uint8_t VL53L0X_latency_get_count(void) { return latency_count; }
+
+const VL53L0X_LatencyEntry_t *VL53L0X_latency_get_entry(uint8_t index) {
+  if (index >= latency_count)
+    return NULL;
+  return &latency_table[index];
+}
+
+uint32_t VL53L0X_latency_get_dropped(void) { return latency_dropped; }
+
+#endif
@@ -459,6 +459,25 @@ VL53L0X_GetTuningSettingBuffer(VL53L0X_DEV Dev, uint8_t **ppTuningSettingBuffer,
  */
 VL53L0X_API VL53L0X_Error VL53L0X_StaticInit(VL53L0X_DEV Dev);
 
+/**
+ * @brief Run the next step of VL53L0X_StaticInit()
+ * Does the same as VL53L0X_StaticInit() a few milliseconds of I2C at a
+ * time, so other devices can be serviced between the steps. Set
+ * pState->Step to VL53L0X_INITSTEP_NVM to start, then call until it reads
+ * VL53L0X_INITSTEP_DONE or an error is returned.
+ *
+ * @note This function Access to the device
+ * @note The reference SPAD management, only done when the NVM holds no
+ * valid reference SPADs, still blocks
+ *
+ * @param   Dev                   Device Handle
+ * @param   pState                Progress of the static init
+ * @return  VL53L0X_ERROR_NONE     Success
+ * @return  "Other error code"    See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_StaticInitStep(VL53L0X_DEV Dev,
+                                                 VL53L0X_InitState_t *pState);
+
 /**
  * @brief Wait for device booted after chip enable (hardware standby)
  * This function can be run only when VL53L0X_State is VL53L0X_STATE_POWERDOWN.
@@ -1357,8 +1376,8 @@ VL53L0X_API VL53L0X_Error VL53L0X_PerformXTalkMeasurement(
  *
  * @note This function Access to the device
  *
- * @note This function change the device mode to
- * VL53L0X_DEVICEMODE_SINGLE_RANGING
+ * @note This function does not change the device mode, the 50 ranges
+ * are taken back to back.
  *
  * @param   Dev                  Device Handle
  * @param   XTalkCalDistance     XTalkCalDistance value used for the XTalk
@@ -1372,6 +1391,33 @@ VL53L0X_API VL53L0X_Error VL53L0X_PerformXTalkCalibration(
     VL53L0X_DEV Dev, FixPoint1616_t XTalkCalDistance,
     FixPoint1616_t *pXTalkCompensationRateMegaCps);
 
+/**
+ * @brief Perform XTalk Calibration until it converges
+ *
+ * @details Same as VL53L0X_PerformXTalkCalibration but the number of
+ * ranges is set by pConvergence: the calibration stops as soon as the
+ * XTalk rate is known to within pConvergence->Tolerance MCPS.
+ *
+ * @warning This function is a blocking function
+ *
+ * @note This function Access to the device
+ *
+ * @param   Dev                  Device Handle
+ * @param   XTalkCalDistance     XTalkCalDistance value used for the XTalk
+ * computation.
+ * @param   pConvergence         Sample counts and tolerance, NULL for 50
+ * ranges.
+ * @param   pXTalkCompensationRateMegaCps  Pointer to new
+ * XTalkCompensation value.
+ * @param   pSamples             Optional, number of ranges taken.
+ * @return  VL53L0X_ERROR_NONE    Success
+ * @return  "Other error code"   See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_PerformXTalkCalibrationConverged(
+    VL53L0X_DEV Dev, FixPoint1616_t XTalkCalDistance,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    FixPoint1616_t *pXTalkCompensationRateMegaCps, uint16_t *pSamples);
+
 /**
  * @brief Perform Offset Calibration
  *
@@ -1401,6 +1447,36 @@ VL53L0X_API VL53L0X_Error VL53L0X_PerformOffsetCalibration(
     VL53L0X_DEV Dev, FixPoint1616_t CalDistanceMilliMeter,
     int32_t *pOffsetMicroMeter);
 
+/**
+ * @brief Perform Offset Calibration until it converges
+ *
+ * @details Same as VL53L0X_PerformOffsetCalibration but the number of
+ * ranges is set by pConvergence: the calibration stops as soon as the
+ * offset is known to within pConvergence->Tolerance mm.
+ *
+ * @warning This function is a blocking function
+ *
+ * @note This function Access to the device
+ *
+ * @note This function does not change the device mode.
+ *
+ * @param   Dev                  Device Handle
+ * @param   CalDistanceMilliMeter     Calibration distance value used for the
+ * offset compensation.
+ * @param   pConvergence         Sample counts and tolerance, NULL for 50
+ * ranges.
+ * @param   pOffsetMicroMeter  Pointer to new Offset value computed by the
+ * function.
+ * @param   pSamples             Optional, number of ranges taken.
+ *
+ * @return  VL53L0X_ERROR_NONE    Success
+ * @return  "Other error code"   See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_PerformOffsetCalibrationConverged(
+    VL53L0X_DEV Dev, FixPoint1616_t CalDistanceMilliMeter,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    int32_t *pOffsetMicroMeter, uint16_t *pSamples);
+
 /**
  * @brief Start device measurement
  *
@@ -1562,6 +1638,68 @@ VL53L0X_API VL53L0X_Error VL53L0X_GetHistogramMeasurementData(
 VL53L0X_API VL53L0X_Error VL53L0X_PerformSingleRangingMeasurement(
     VL53L0X_DEV Dev, VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
 
+/**
+ * @brief Set the device up for VL53L0X_PerformPreparedSingleRanging()
+ *
+ * @par Function Description
+ * Changes the device mode to VL53L0X_DEVICEMODE_SINGLE_RANGING and loads the
+ * stop variable that VL53L0X_StartMeasurement() writes before every range.
+ * Changing the device or power mode, or stopping a measurement, undoes it.
+ *
+ * @note This function Access to the device
+ *
+ * @param   Dev                       Device Handle
+ * @return  VL53L0X_ERROR_NONE         Success
+ * @return  "Other error code"        See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_PrepareSingleRanging(VL53L0X_DEV Dev);
+
+/**
+ * @brief Performs a single ranging measurement on a prepared device
+ *
+ * @par Function Description
+ * Same result as VL53L0X_PerformSingleRangingMeasurement(), but the device
+ * is only prepared with @a VL53L0X_PrepareSingleRanging() when it is not
+ * already. A range then takes the start write, the data ready wait, the
+ * result read and the interrupt clear.
+ *
+ * @note This function Access to the device
+ *
+ * @param   Dev                       Device Handle
+ * @param   pRangingMeasurementData   Pointer to the data structure to fill up.
+ * @return  VL53L0X_ERROR_NONE         Success
+ * @return  "Other error code"        See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_PerformPreparedSingleRanging(
+    VL53L0X_DEV Dev, VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+/**
+ * @brief Read a finished range, clear its interrupt and start the next one
+ *
+ * @par Function Description
+ * Does what VL53L0X_GetRangingMeasurementData() followed by
+ * VL53L0X_ClearInterruptMask() does and, in single ranging mode, starts the
+ * next range, chaining the transfers. The range is decoded once the next one
+ * is started. In continuous modes the device starts the next range itself.
+ * With @a CheckInterruptClear set to 0 the interrupt status is not read
+ * back after the clear, which saves a transfer on a bus that does not lose
+ * writes; the next range is then started in the same chain.
+ *
+ * @note This function Access to the device
+ *
+ * @param   Dev                       Device Handle
+ * @param   pRangingMeasurementData   Pointer to the data structure to fill up.
+ * @param   CheckInterruptClear       Read back the interrupt status, and
+ *                                    clear again if needed, before starting
+ * @return  VL53L0X_ERROR_NONE         Success
+ * @return  VL53L0X_ERROR_INTERRUPT_NOT_CLEARED  Cannot clear interrupts,
+ *                                    no range was started
+ * @return  "Other error code"        See ::VL53L0X_Error
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_GetMeasurementDataAndRearm(
+    VL53L0X_DEV Dev, VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
+    uint8_t CheckInterruptClear);
+
 /**
  * @brief Performs a single histogram measurement and retrieve the histogram
  * measurement data
@@ -1961,6 +2099,39 @@ VL53L0X_API VL53L0X_Error VL53L0X_GetReferenceSpads(VL53L0X_DEV Dev,
                                                     uint32_t *refSpadCount,
                                                     uint8_t *isApertureSpads);
 
+/**
+ * @brief Set when the reference SPAD map writes are read back
+ *
+ * @par Function Description
+ * The reference SPAD management reads the map back after each write and
+ * fails if it differs. On a clean bus this doubles the I2C traffic of the
+ * map updates. VL53L0X_VERIFY_FIRST only reads back until one write
+ * verified, VL53L0X_VERIFY_NEVER never reads back.
+ *
+ * @note This function does not Access to the device
+ *
+ * @param   Dev                          Device Handle
+ * @param   Policy                       See ::VL53L0X_VerifyPolicy
+ * @return  VL53L0X_ERROR_NONE            Success
+ * @return  VL53L0X_ERROR_INVALID_PARAMS  Unknown policy
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_SetVerifyPolicy(VL53L0X_DEV Dev,
+                                                  VL53L0X_VerifyPolicy Policy);
+
+/**
+ * @brief Number of writes that did not read back what was written
+ *
+ * @note This function does not Access to the device
+ *
+ * @param   Dev                          Device Handle
+ * @param   pFailCount                   Failed verifications since the
+ *                                       device data was cleared, saturates
+ *                                       at 0xFFFF
+ * @return  VL53L0X_ERROR_NONE            Success
+ */
+VL53L0X_API VL53L0X_Error VL53L0X_GetVerifyFailCount(VL53L0X_DEV Dev,
+                                                     uint16_t *pFailCount);
+
 /** @} VL53L0X_SPADfunctions_group */
 
 /** @} VL53L0X_cut11_group */
@@ -38,12 +38,13 @@ extern "C" {
 
 VL53L0X_Error VL53L0X_perform_xtalk_calibration(
     VL53L0X_DEV Dev, FixPoint1616_t XTalkCalDistance,
-    FixPoint1616_t *pXTalkCompensationRateMegaCps);
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    FixPoint1616_t *pXTalkCompensationRateMegaCps, uint16_t *pSamples);
 
-VL53L0X_Error
-VL53L0X_perform_offset_calibration(VL53L0X_DEV Dev,
-                                   FixPoint1616_t CalDistanceMilliMeter,
-                                   int32_t *pOffsetMicroMeter);
+VL53L0X_Error VL53L0X_perform_offset_calibration(
+    VL53L0X_DEV Dev, FixPoint1616_t CalDistanceMilliMeter,
+    const VL53L0X_CalibrationConvergence_t *pConvergence,
+    int32_t *pOffsetMicroMeter, uint16_t *pSamples);
 
 VL53L0X_Error VL53L0X_set_offset_calibration_data_micro_meter(
     VL53L0X_DEV Dev, int32_t OffsetCalibrationDataMicroMeter);
@@ -57,6 +58,22 @@ VL53L0X_Error VL53L0X_perform_ref_spad_management(VL53L0X_DEV Dev,
                                                   uint32_t *refSpadCount,
                                                   uint8_t *isApertureSpads);
 
+void VL53L0X_calibration_init(VL53L0X_CalibrationState_t *pState,
+                              VL53L0X_CalibrationStep Step);
+
+VL53L0X_Error VL53L0X_calibration_step(VL53L0X_DEV Dev,
+                                       VL53L0X_CalibrationState_t *pState);
+
+VL53L0X_Error VL53L0X_start_single_ref_calibration(VL53L0X_DEV Dev,
+                                                   uint8_t vhv_init_byte);
+
+VL53L0X_Error VL53L0X_end_single_ref_calibration(VL53L0X_DEV Dev);
+
+VL53L0X_Error VL53L0X_ref_calibration_io(
+    VL53L0X_DEV Dev, uint8_t read_not_write, uint8_t VhvSettings,
+    uint8_t PhaseCal, uint8_t *pVhvSettings, uint8_t *pPhaseCal,
+    const uint8_t vhv_enable, const uint8_t phase_enable);
+
 VL53L0X_Error VL53L0X_set_reference_spads(VL53L0X_DEV Dev, uint32_t count,
                                           uint8_t isApertureSpads);
 
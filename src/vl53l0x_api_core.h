@@ -38,6 +38,8 @@ extern "C" {
 
 VL53L0X_Error VL53L0X_reverse_bytes(uint8_t *data, uint32_t size);
 
+uint8_t VL53L0X_gpio_data_ready_enabled(VL53L0X_DEV Dev);
+
 VL53L0X_Error VL53L0X_measurement_poll_for_completion(VL53L0X_DEV Dev);
 
 uint8_t VL53L0X_encode_vcsel_period(uint8_t vcsel_period_pclks);
@@ -50,6 +52,19 @@ uint32_t VL53L0X_quadrature_sum(uint32_t a, uint32_t b);
 
 VL53L0X_Error VL53L0X_get_info_from_device(VL53L0X_DEV Dev, uint8_t option);
 
+VL53L0X_Error VL53L0X_get_part_uid(VL53L0X_DEV Dev, uint32_t *pPartUIDUpper,
+                                   uint32_t *pPartUIDLower);
+
+VL53L0X_Error VL53L0X_get_nvm_info(VL53L0X_DEV Dev,
+                                   VL53L0X_NvmInfo_t *pNvmInfo);
+
+VL53L0X_Error VL53L0X_set_nvm_info(VL53L0X_DEV Dev,
+                                   const VL53L0X_NvmInfo_t *pNvmInfo);
+
+VL53L0X_Error
+VL53L0X_get_device_signature(VL53L0X_DEV Dev,
+                             VL53L0X_DeviceSignature_t *pSignature);
+
 VL53L0X_Error
 VL53L0X_set_vcsel_pulse_period(VL53L0X_DEV Dev,
                                VL53L0X_VcselPeriod VcselPeriodType,
@@ -60,6 +75,12 @@ VL53L0X_get_vcsel_pulse_period(VL53L0X_DEV Dev,
                                VL53L0X_VcselPeriod VcselPeriodType,
                                uint8_t *pVCSELPulsePeriodPCLK);
 
+VL53L0X_Error VL53L0X_capture_profile(VL53L0X_DEV Dev,
+                                      VL53L0X_Profile_t *pProfile);
+
+VL53L0X_Error VL53L0X_apply_profile(VL53L0X_DEV Dev,
+                                    const VL53L0X_Profile_t *pProfile);
+
 uint32_t VL53L0X_decode_timeout(uint16_t encoded_timeout);
 
 VL53L0X_Error get_sequence_step_timeout(VL53L0X_DEV Dev,
@@ -76,9 +97,52 @@ VL53L0X_Error VL53L0X_set_measurement_timing_budget_micro_seconds(
 VL53L0X_Error VL53L0X_get_measurement_timing_budget_micro_seconds(
     VL53L0X_DEV Dev, uint32_t *pMeasurementTimingBudgetMicroSeconds);
 
+VL53L0X_Error VL53L0X_get_budget_plan(VL53L0X_DEV Dev,
+                                      VL53L0X_BudgetPlan_t *pPlan);
+
+VL53L0X_Error
+VL53L0X_set_budget_from_plan(VL53L0X_DEV Dev, const VL53L0X_BudgetPlan_t *pPlan,
+                             uint32_t MeasurementTimingBudgetMicroSeconds);
+
+VL53L0X_Error VL53L0X_read_raw_result(VL53L0X_DEV Dev,
+                                      VL53L0X_RawResult_t *pRawResult);
+
+VL53L0X_Error VL53L0X_consume_raw_result(VL53L0X_DEV Dev,
+                                         VL53L0X_RawResult_t *pRawResult,
+                                         uint8_t ClearInterrupt,
+                                         uint8_t StartMode,
+                                         uint8_t *pInterruptStatus);
+
+VL53L0X_Error VL53L0X_decode_ranging_result(
+    VL53L0X_DEV Dev, const VL53L0X_RawResult_t *pRawResult,
+    VL53L0X_RangingMeasurementData_t *pRangingMeasurementData);
+
+VL53L0X_Error VL53L0X_get_decode_config(VL53L0X_DEV Dev,
+                                        VL53L0X_DecodeConfig_t *pConfig);
+
+VL53L0X_Error VL53L0X_set_decode_config(VL53L0X_DEV Dev,
+                                        const VL53L0X_DecodeConfig_t *pConfig);
+
+void VL53L0X_pack_raw_result(const VL53L0X_RawResult_t *pRawResult,
+                             uint8_t *pBuffer);
+
+void VL53L0X_unpack_raw_result(const uint8_t *pBuffer,
+                               VL53L0X_RawResult_t *pRawResult);
+
+void VL53L0X_pack_decode_config(const VL53L0X_DecodeConfig_t *pConfig,
+                                uint8_t *pBuffer);
+
+VL53L0X_Error VL53L0X_unpack_decode_config(const uint8_t *pBuffer,
+                                           VL53L0X_DecodeConfig_t *pConfig);
+
 VL53L0X_Error VL53L0X_load_tuning_settings(VL53L0X_DEV Dev,
                                            uint8_t *pTuningSettingBuffer);
 
+VL53L0X_Error VL53L0X_load_tuning_settings_part(VL53L0X_DEV Dev,
+                                                uint8_t *pTuningSettingBuffer,
+                                                uint16_t *pIndex,
+                                                uint16_t MaxWrites);
+
 VL53L0X_Error VL53L0X_calc_sigma_estimate(
     VL53L0X_DEV Dev, VL53L0X_RangingMeasurementData_t *pRangingMeasurementData,
     FixPoint1616_t *pSigmaEstimate, uint32_t *pDmax_mm);
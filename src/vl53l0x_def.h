@@ -83,6 +83,22 @@ extern "C" {
 #define VL53L0X_DEFAULT_MAX_LOOP 200
 #define VL53L0X_MAX_STRING_LENGTH 32
 
+/** Drop from VL53L0X_DevData_t what the PAL keeps but never needs, to fit
+ * more devices in a small RAM. On by default on AVR */
+#ifndef VL53L0X_SLIM
+#ifdef ARDUINO_ARCH_AVR
+#define VL53L0X_SLIM 1
+#else
+#define VL53L0X_SLIM 0
+#endif
+#endif
+
+/** Find the reference SPAD count with the original walk, one SPAD and one
+ * measurement at a time, instead of bracketing it */
+#ifndef VL53L0X_REF_SPAD_LINEAR_SEARCH
+#define VL53L0X_REF_SPAD_LINEAR_SEARCH 0
+#endif
+
 #include "vl53l0x_device.h"
 #include "vl53l0x_types.h"
 
@@ -217,6 +233,24 @@ typedef uint8_t VL53L0X_PowerModes;
 
 /** @} VL53L0X_define_PowerModes_group */
 
+/** @defgroup VL53L0X_define_VerifyPolicy_group Defines when register writes
+ *	are read back
+ *	Defines when a write the PAL reads back to compare, the reference SPAD
+ *	map, is verified
+ *	@{
+ */
+
+typedef uint8_t VL53L0X_VerifyPolicy;
+
+#define VL53L0X_VERIFY_ALWAYS ((VL53L0X_VerifyPolicy)0)
+/*!< Read back every write, the default */
+#define VL53L0X_VERIFY_FIRST ((VL53L0X_VerifyPolicy)1)
+/*!< Read back until a write verified once since the policy was set */
+#define VL53L0X_VERIFY_NEVER ((VL53L0X_VerifyPolicy)2)
+/*!< Trust the bus, never read back */
+
+/** @} VL53L0X_define_VerifyPolicy_group */
+
 /** @brief Defines all parameters for the device
  */
 typedef struct {
@@ -362,6 +396,296 @@ typedef struct {
   /*!< Reference Spad Good Spad Map */
 } VL53L0X_SpadData_t;
 
+/** @defgroup VL53L0X_define_CalibrationStep_group Defines the steps of a
+ *	resumable reference calibration
+ *	@{
+ */
+typedef uint8_t VL53L0X_CalibrationStep;
+
+#define VL53L0X_CALSTEP_DONE ((VL53L0X_CalibrationStep)0)
+/*!< Nothing left to do */
+#define VL53L0X_CALSTEP_SPAD_START ((VL53L0X_CalibrationStep)1)
+/*!< Ref SPAD management: setup and start VHV calibration */
+#define VL53L0X_CALSTEP_SPAD_VHV ((VL53L0X_CalibrationStep)2)
+/*!< Ref SPAD management: waiting for VHV calibration */
+#define VL53L0X_CALSTEP_SPAD_PHASE ((VL53L0X_CalibrationStep)3)
+/*!< Ref SPAD management: waiting for phase calibration */
+#define VL53L0X_CALSTEP_SPAD_MIN ((VL53L0X_CalibrationStep)4)
+/*!< Ref SPAD management: measuring minimum non-aperture SPADs */
+#define VL53L0X_CALSTEP_SPAD_MIN_APT ((VL53L0X_CalibrationStep)5)
+/*!< Ref SPAD management: measuring minimum aperture SPADs */
+#define VL53L0X_CALSTEP_SPAD_ADD ((VL53L0X_CalibrationStep)6)
+/*!< Ref SPAD management: measuring after adding a SPAD */
+#define VL53L0X_CALSTEP_SPAD_SEARCH ((VL53L0X_CalibrationStep)7)
+/*!< Ref SPAD management: measuring a SPAD count of the bracketing search */
+#define VL53L0X_CALSTEP_REF_START ((VL53L0X_CalibrationStep)8)
+/*!< Ref calibration: start VHV calibration */
+#define VL53L0X_CALSTEP_REF_VHV ((VL53L0X_CalibrationStep)9)
+/*!< Ref calibration: waiting for VHV calibration */
+#define VL53L0X_CALSTEP_REF_PHASE ((VL53L0X_CalibrationStep)10)
+/*!< Ref calibration: waiting for phase calibration */
+
+/** @} VL53L0X_define_CalibrationStep_group */
+
+/**
+ * @struct VL53L0X_CalibrationState_t
+ * @brief Progress of a reference calibration run one step at a time, so
+ * the device side measurements of several devices can overlap.
+ */
+typedef struct {
+  VL53L0X_CalibrationStep Step;
+  /*!< Next step to run, VL53L0X_CALSTEP_DONE when finished */
+  uint8_t SequenceConfig;
+  /*!< Sequence config to restore once the running measurement is over */
+  uint8_t NeedAptSpads;
+  /*!< SPAD type currently being enabled */
+  uint8_t IsApertureSpads;
+  /*!< Result: reference SPADs are aperture SPADs */
+  uint8_t VhvSettings;
+  /*!< Result: VHV setting of the ref calibration */
+  uint8_t PhaseCal;
+  /*!< Result: phase calibration of the ref calibration */
+  uint8_t LastSpadArray[VL53L0X_REF_SPAD_BUFFER_SIZE];
+  /*!< SPAD map that gave the previous measurement, when searching the
+   * largest map known to stay at or below the target rate */
+  uint16_t PeakSignalRateRef;
+  /*!< Last reference signal rate measured, 9.7 format */
+  uint32_t CurrentSpadIndex;
+  /*!< Next SPAD to consider */
+  uint32_t RefSpadCount;
+  /*!< Result: number of reference SPADs enabled */
+  uint32_t LastSignalRateDiff;
+  /*!< Distance to the target rate of the previous measurement */
+  uint32_t PollCount;
+  /*!< Number of times the running measurement was found not ready */
+  uint32_t SearchStep;
+  /*!< SPADs the running search measurement adds to LastSpadArray */
+  uint32_t SearchHigh;
+  /*!< SPADs to add to LastSpadArray to exceed the target, 0 if unknown */
+  uint32_t HighSignalRateDiff;
+  /*!< Distance to the target rate of the SearchHigh SPAD map */
+  uint8_t SearchProbes;
+  /*!< Number of search measurements done */
+} VL53L0X_CalibrationState_t;
+
+/** @defgroup VL53L0X_define_InitStep_group Defines the steps of a resumable
+ *	static init
+ *	@{
+ */
+typedef uint8_t VL53L0X_InitStep;
+
+#define VL53L0X_INITSTEP_DONE ((VL53L0X_InitStep)0)
+/*!< Nothing left to do */
+#define VL53L0X_INITSTEP_NVM ((VL53L0X_InitStep)1)
+/*!< Read the reference SPADs from NVM */
+#define VL53L0X_INITSTEP_REF_SPADS ((VL53L0X_InitStep)2)
+/*!< Set the reference SPADs */
+#define VL53L0X_INITSTEP_TUNING ((VL53L0X_InitStep)3)
+/*!< Load the next part of the tuning settings */
+#define VL53L0X_INITSTEP_PARAMETERS ((VL53L0X_InitStep)4)
+/*!< Configure GPIO and read back the device parameters */
+#define VL53L0X_INITSTEP_SEQUENCE ((VL53L0X_InitStep)5)
+/*!< Set up and read back the sequence steps */
+
+/** @} VL53L0X_define_InitStep_group */
+
+/** Tuning settings register writes per VL53L0X_INITSTEP_TUNING step */
+#ifndef VL53L0X_TUNING_WRITES_PER_STEP
+#define VL53L0X_TUNING_WRITES_PER_STEP 16
+#endif
+
+/**
+ * @struct VL53L0X_InitState_t
+ * @brief Progress of a static init run one step at a time
+ */
+typedef struct {
+  VL53L0X_InitStep Step;
+  /*!< Next step to run, VL53L0X_INITSTEP_DONE when finished */
+  uint16_t TuningIndex;
+  /*!< Offset of the next tuning settings entry to load */
+} VL53L0X_InitState_t;
+
+/**
+ * @struct VL53L0X_CalibrationConvergence_t
+ * @brief When the xtalk and offset calibrations stop averaging ranges
+ */
+typedef struct {
+  uint16_t MinSamples;
+  /*!< Valid ranges to average before stopping early */
+  uint16_t MaxSamples;
+  /*!< Ranges after which the calibration stops, valid or not */
+  FixPoint1616_t Tolerance;
+  /*!< Stop early once the 95% confidence interval of the result is within
+   * plus or minus this: mm for the offset, MCPS for the xtalk rate.
+   * 0 always takes MaxSamples ranges */
+} VL53L0X_CalibrationConvergence_t;
+
+#define VL53L0X_NVM_PRODUCT_ID_LENGTH 19
+/*!< Product ID string stored in NVM, with its terminating zero */
+
+/**
+ * @struct VL53L0X_NvmInfo_t
+ * @brief Everything VL53L0X_get_info_from_device() decodes from the NVM of a
+ * part, so it can be kept by the host and given back instead of read again.
+ */
+typedef struct {
+  uint8_t Valid;
+  /*!< 1 once filled by VL53L0X_get_nvm_info() */
+  uint8_t ModuleId;
+  /*!< Module ID */
+  uint8_t Revision;
+  /*!< Test revision */
+  uint8_t ReferenceSpadCount;
+  /*!< Reference SPAD count programmed at the factory */
+  uint8_t ReferenceSpadType;
+  /*!< Reference SPAD type programmed at the factory */
+  uint8_t RefGoodSpadMap[VL53L0X_REF_SPAD_BUFFER_SIZE];
+  /*!< Reference good SPAD map */
+  char ProductId[VL53L0X_NVM_PRODUCT_ID_LENGTH];
+  /*!< Product identifier string */
+  uint32_t PartUIDUpper;
+  /*!< Unique part ID upper word, key of the image */
+  uint32_t PartUIDLower;
+  /*!< Unique part ID lower word, key of the image */
+  FixPoint1616_t SignalRateMeasFixed400mm;
+  /*!< Peak signal rate at 400 mm */
+  int32_t OffsetMicroMeters;
+  /*!< Part to part offset adjustment */
+} VL53L0X_NvmInfo_t;
+
+#define VL53L0X_PROFILE_REGISTER_COUNT 19
+/*!< Device registers held by a VL53L0X_Profile_t */
+#define VL53L0X_PROFILE_CAPTURED 1
+/*!< Profile read from a device, phase calibration included */
+#define VL53L0X_PROFILE_BUILT 2
+/*!< Profile built offline, phase calibration still to be done */
+
+/**
+ * @struct VL53L0X_Profile_t
+ * @brief Ranging profile (VCSEL periods, timeouts, limit checks and the
+ * phase calibration that goes with the VCSEL periods) captured from a
+ * configured device, so it can be put back without recalibrating.
+ */
+typedef struct {
+  uint8_t Valid;
+  /*!< VL53L0X_PROFILE_CAPTURED or VL53L0X_PROFILE_BUILT, 0 if invalid */
+  uint8_t PreRangeVcselPulsePeriod;
+  /*!< Pre-range VCSEL period in PCLKs */
+  uint8_t FinalRangeVcselPulsePeriod;
+  /*!< Final range VCSEL period in PCLKs */
+  uint8_t PhaseCal;
+  /*!< Phase calibration for these VCSEL periods, if captured */
+  uint8_t PhasecalLimit;
+  /*!< ALGO_PHASECAL_LIM, on register page 1 */
+  uint8_t Registers[VL53L0X_PROFILE_REGISTER_COUNT];
+  /*!< Sequence, phase and timeout registers in page 0 */
+  uint8_t LimitChecksEnable[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+  /*!< Limit checks enabled */
+  FixPoint1616_t LimitChecksValue[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+  /*!< Limit check values */
+  uint32_t MeasurementTimingBudgetMicroSeconds;
+  /*!< Timing budget */
+  uint32_t FinalRangeTimeoutMicroSecs;
+  /*!< Final range timeout */
+  uint32_t PreRangeTimeoutMicroSecs;
+  /*!< Pre-range timeout */
+  uint16_t LastEncodedTimeout;
+  /*!< Last encoded final range timeout */
+} VL53L0X_Profile_t;
+
+/**
+ * @struct VL53L0X_DeviceSignature_t
+ * @brief A few registers that tell whether a device kept the state a host
+ * put it in, read by VL53L0X_get_device_signature().
+ */
+typedef struct {
+  uint8_t ModelId;
+  /*!< Model ID, 0xEE for a VL53L0X */
+  uint8_t I2cAddress;
+  /*!< 7 bit address programmed in the device */
+  uint8_t StopVariable;
+  /*!< Stop variable, as read by VL53L0X_DataInit() */
+  uint8_t SequenceConfig;
+  /*!< Enabled sequence steps */
+  uint8_t GpioConfig;
+  /*!< GPIO interrupt configuration */
+  uint8_t PreRangeVcselPeriod;
+  /*!< Encoded pre-range VCSEL period */
+  uint8_t FinalRangeVcselPeriod;
+  /*!< Encoded final range VCSEL period */
+  uint8_t RefSpadEnables[VL53L0X_REF_SPAD_BUFFER_SIZE];
+  /*!< Reference SPADs, set by the ref SPAD management */
+} VL53L0X_DeviceSignature_t;
+
+/**
+ * @struct VL53L0X_BudgetPlan_t
+ * @brief What VL53L0X_set_measurement_timing_budget_micro_seconds() reads
+ * from the device before it can write the final range timeout, so the
+ * timing budget can be changed again with that write only.
+ */
+typedef struct {
+  uint32_t OverheadMicroSeconds;
+  /*!< Start, end, TCC, MSRC/DSS and pre-range time, with overheads */
+  uint16_t PreRangeTimeOutMClks;
+  /*!< Pre-range timeout added to the final range one, 0 if pre-range off */
+  uint8_t FinalRangeVcselPulsePeriod;
+  /*!< Final range VCSEL period in PCLKs */
+  uint8_t FinalRangeOn;
+  /*!< Final range step enabled */
+} VL53L0X_BudgetPlan_t;
+
+#define VL53L0X_RESULT_BLOCK_SIZE 12 /*!< Bytes from RESULT_RANGE_STATUS on */
+
+/**
+ * @struct VL53L0X_RawResult_t
+ * @brief Everything VL53L0X_GetRangingMeasurementData() reads from the
+ * device, so a range can be decoded again away from the device with
+ * VL53L0X_decode_ranging_result().
+ */
+typedef struct {
+  uint8_t ResultBlock[VL53L0X_RESULT_BLOCK_SIZE];
+  /*!< Result registers from RESULT_RANGE_STATUS (0x14) on */
+  uint16_t SignalRefRaw;
+  /*!< RESULT_PEAK_SIGNAL_RATE_REF, 9.7 Mcps */
+} VL53L0X_RawResult_t;
+
+#define VL53L0X_RAW_RESULT_PACKED_SIZE 14 /*!< VL53L0X_pack_raw_result() */
+
+/**
+ * @struct VL53L0X_DecodeConfig_t
+ * @brief The device configuration VL53L0X_decode_ranging_result() depends
+ * on, to go with captured raw results.
+ */
+typedef struct {
+  uint16_t LinearityCorrectiveGain;
+  /*!< Linearity corrective gain x1000 */
+  uint8_t RangeFractionalEnable;
+  /*!< Fractional range output enabled */
+  uint8_t XTalkCompensationEnable;
+  /*!< Crosstalk compensation enabled */
+  FixPoint1616_t XTalkCompensationRateMegaCps;
+  /*!< Crosstalk compensation rate per SPAD */
+  uint8_t LimitChecksEnable[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+  /*!< Limit checks enabled */
+  FixPoint1616_t LimitChecksValue[VL53L0X_CHECKENABLE_NUMBER_OF_CHECKS];
+  /*!< Limit check values */
+  uint32_t FinalRangeTimeoutMicroSecs;
+  /*!< Final range timeout, for the sigma estimate */
+  uint32_t PreRangeTimeoutMicroSecs;
+  /*!< Pre-range timeout, for the sigma estimate */
+  uint8_t FinalRangeVcselPulsePeriod;
+  /*!< Final range VCSEL period in PCLKs */
+  uint8_t PreRangeVcselPulsePeriod;
+  /*!< Pre-range VCSEL period in PCLKs */
+  uint16_t DmaxCalRangeMilliMeter;
+  /*!< Dmax calibration range */
+  FixPoint1616_t DmaxCalSignalRateRtnMegaCps;
+  /*!< Dmax calibration signal rate */
+} VL53L0X_DecodeConfig_t;
+
+#define VL53L0X_DECODE_CONFIG_VERSION 1 /*!< First packed byte */
+#define VL53L0X_DECODE_CONFIG_PACKED_SIZE 55 /*!< Version byte included */
+
 typedef struct {
   FixPoint1616_t OscFrequencyMHz; /* Frequency used */
 
@@ -370,6 +694,8 @@ typedef struct {
 
   VL53L0X_GpioFunctionality Pin0GpioFunctionality;
   /* store the functionality of the GPIO: pin0 */
+  uint8_t Pin0GpioPolarity;
+  /*!< VL53L0X_INTERRUPTPOLARITY_... of pin0, level when the interrupt is set */
 
   uint32_t FinalRangeTimeoutMicroSecs;
   /*!< Execution time of the final range*/
@@ -393,7 +719,11 @@ typedef struct {
   been done (==1) or not (==0) */
   uint8_t ModuleId;               /* Module ID */
   uint8_t Revision;               /* test Revision */
+#if VL53L0X_SLIM
+  char ProductId[VL53L0X_NVM_PRODUCT_ID_LENGTH];
+#else
   char ProductId[VL53L0X_MAX_STRING_LENGTH];
+#endif
   /* Product Identifier String  */
   uint8_t ReferenceSpadCount;  /* used for ref spad management */
   uint8_t ReferenceSpadType;   /* used for ref spad management */
@@ -424,8 +754,10 @@ typedef struct {
   /*!< Current Device Parameter */
   VL53L0X_RangingMeasurementData_t LastRangeMeasure;
   /*!< Ranging Data */
+#if !VL53L0X_SLIM
   VL53L0X_HistogramMeasurementData_t LastHistogramMeasure;
-  /*!< Histogram Data */
+  /*!< Histogram Data, histograms are not supported by this device */
+#endif
   VL53L0X_DeviceSpecificParameters_t DeviceSpecificParameters;
   /*!< Parameters specific to the device */
   VL53L0X_SpadData_t SpadData;
@@ -467,6 +799,14 @@ typedef struct {
   /*!< Dmax Calibration Range millimeter */
   FixPoint1616_t DmaxCalSignalRateRtnMegaCps;
   /*!< Dmax Calibration Signal Rate Return MegaCps */
+  VL53L0X_VerifyPolicy VerifyPolicy;
+  /*!< When writes are read back, see ::VL53L0X_VerifyPolicy */
+  uint8_t VerifyDone;
+  /*!< A write verified since the policy was set */
+  uint16_t VerifyFailCount;
+  /*!< Writes that read back different, saturates */
+  uint8_t SingleRangingPrepared;
+  /*!< Stop variable loaded by VL53L0X_PrepareSingleRanging */
 
 } VL53L0X_DevData_t;
 
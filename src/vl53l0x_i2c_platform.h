@@ -1,3 +1,6 @@
+#ifndef _VL53L0X_I2C_PLATFORM_H_
+#define _VL53L0X_I2C_PLATFORM_H_
+
 #include "Arduino.h"
 #include "Wire.h"
 
@@ -19,3 +22,54 @@ int VL53L0X_read_word(uint8_t deviceAddress, uint8_t index, uint16_t *data,
                       TwoWire *i2c);
 int VL53L0X_read_dword(uint8_t deviceAddress, uint8_t index, uint32_t *data,
                        TwoWire *i2c);
+
+// Same as write_multi and read_multi, returning the endTransmission() status.
+// With stop 0 the bus is kept with a repeated start for the next transfer.
+int VL53L0X_write_chain(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                        uint32_t count, TwoWire *i2c, uint8_t stop);
+int VL53L0X_read_chain(uint8_t deviceAddress, uint8_t index, uint8_t *pdata,
+                       uint32_t count, TwoWire *i2c, uint8_t stop);
+
+// Set to 0 for a TwoWire that can not hold the bus between transfers, the
+// register batches then end every transfer with a stop
+#ifndef VL53L0X_I2C_REPEATED_START
+#define VL53L0X_I2C_REPEATED_START 1
+#endif
+
+// Flag ORed into an endTransmission() status when fewer bytes were read
+#define VL53L0X_I2C_STATUS_SHORT 0x80
+
+// Uncomment, or define for the whole build, to record every register
+// transaction into a ring buffer, see Adafruit_VL53L0X::printI2CTrace()
+//#define VL53L0X_I2C_TRACE
+
+#ifdef VL53L0X_I2C_TRACE
+
+#ifndef VL53L0X_I2C_TRACE_SIZE
+#define VL53L0X_I2C_TRACE_SIZE 64 ///< Transactions kept, 16 bytes each
+#endif
+
+#define VL53L0X_I2C_TRACE_DATA 4  ///< Data bytes kept per transaction
+#define VL53L0X_I2C_TRACE_WRITE 0 ///< Register write
+#define VL53L0X_I2C_TRACE_READ 1  ///< Register read
+
+/** One register transaction */
+typedef struct {
+  uint32_t micros;   ///< micros() at the start
+  uint16_t duration; ///< in us, saturates at 0xffff
+  uint8_t address;   ///< 7 bit device address
+  uint8_t op;        ///< VL53L0X_I2C_TRACE_WRITE or _READ
+  uint8_t index;     ///< register
+  uint8_t length;    ///< bytes transferred, saturates at 0xff
+  uint8_t status;    ///< endTransmission() result
+  uint8_t data[VL53L0X_I2C_TRACE_DATA]; ///< first bytes transferred
+} VL53L0X_I2cTraceRecord_t;
+
+void VL53L0X_i2c_trace_reset(void);
+uint32_t VL53L0X_i2c_trace_total(void);
+uint16_t VL53L0X_i2c_trace_count(void);
+const VL53L0X_I2cTraceRecord_t *VL53L0X_i2c_trace_get(uint16_t index);
+
+#endif
+
+#endif /* _VL53L0X_I2C_PLATFORM_H_ */
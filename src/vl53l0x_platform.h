@@ -66,6 +66,17 @@ typedef struct {
 
   TwoWire *i2c;
 
+  void (*RawResultHook)(const VL53L0X_RawResult_t *pRawResult,
+                        void *pContext);
+  /*!< Called with every result block read from the device, NULL if none */
+  void *RawResultContext; /*!< Passed on to RawResultHook */
+
+  uint8_t (*GpioLevelHook)(void *pContext);
+  /*!< Returns the level, 0 or 1, of the host pin wired to GPIO1. Data ready
+   * checks read it instead of the device when GPIO1 signals new samples.
+   * NULL to always ask the device */
+  void *GpioLevelContext; /*!< Passed on to GpioLevelHook */
+
 } VL53L0X_Dev_t;
 
 /**
@@ -220,6 +231,104 @@ VL53L0X_Error VL53L0X_RdDWord(VL53L0X_DEV Dev, uint8_t index, uint32_t *data);
 VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index,
                                  uint8_t AndData, uint8_t OrData);
 
+#ifndef VL53L0X_REG_BATCH_SIZE
+#define VL53L0X_REG_BATCH_SIZE 12 /*!< Register operations in a batch */
+#endif
+
+#define VL53L0X_REGOP_WRITE 0  /*!< Write Data */
+#define VL53L0X_REGOP_READ 1   /*!< Read Length bytes into pData */
+#define VL53L0X_REGOP_UPDATE 2 /*!< Write (register & Mask) | Data */
+#define VL53L0X_REGOP_POLL 3   /*!< Read until (register & Mask) == Data */
+
+/**
+ * @struct  VL53L0X_RegOp_t
+ * @brief   One register operation of a ::VL53L0X_RegBatch_t
+ */
+typedef struct {
+  uint8_t Op;           /*!< VL53L0X_REGOP_... */
+  uint8_t Index;        /*!< The register index */
+  uint8_t Data;         /*!< Value written, ORed or waited for */
+  uint8_t Mask;         /*!< AND mask of UPDATE and POLL */
+  uint8_t Length;       /*!< Bytes a READ stores */
+  uint8_t *pData;       /*!< Where a READ stores the bytes */
+  VL53L0X_Error Status; /*!< Result, VL53L0X_ERROR_UNDEFINED if not run */
+} VL53L0X_RegOp_t;
+
+/**
+ * @struct  VL53L0X_RegBatch_t
+ * @brief   Register operations recorded to be run by VL53L0X_batch_submit()
+ */
+typedef struct {
+  VL53L0X_RegOp_t Ops[VL53L0X_REG_BATCH_SIZE]; /*!< In submission order */
+  uint8_t Count;                               /*!< Operations recorded */
+  uint8_t Overflow; /*!< More were recorded than fit */
+} VL53L0X_RegBatch_t;
+
+/**
+ * Empty a batch
+ * @param   pBatch    The batch
+ */
+void VL53L0X_batch_init(VL53L0X_RegBatch_t *pBatch);
+
+/**
+ * Record a single byte register write
+ * @param   pBatch    The batch
+ * @param   index     The register index
+ * @param   data      8 bit register data
+ */
+void VL53L0X_batch_write(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                         uint8_t data);
+
+/**
+ * Record a register read, pdata is filled by VL53L0X_batch_submit()
+ * @param   pBatch    The batch
+ * @param   index     The register index
+ * @param   pdata     Where to store the bytes read
+ * @param   count     Number of bytes to read
+ */
+void VL53L0X_batch_read(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                        uint8_t *pdata, uint8_t count);
+
+/**
+ * Record a read/modify/write, Final_reg = (Initial_reg & and_data) | or_data
+ * @param   pBatch    The batch
+ * @param   index     The register index
+ * @param   AndData   8 bit and data
+ * @param   OrData    8 bit or data
+ */
+void VL53L0X_batch_update(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                          uint8_t AndData, uint8_t OrData);
+
+/**
+ * Record a wait until (register & mask) == value, VL53L0X_DEFAULT_MAX_LOOP
+ * reads at most
+ * @param   pBatch    The batch
+ * @param   index     The register index
+ * @param   mask      Bits compared
+ * @param   value     Value waited for
+ */
+void VL53L0X_batch_poll(VL53L0X_RegBatch_t *pBatch, uint8_t index,
+                        uint8_t mask, uint8_t value);
+
+/**
+ * Run the recorded operations in order and keep the result of each one
+ *
+ * Writes to consecutive registers go out as a single transfer, and when
+ * VL53L0X_I2C_REPEATED_START is set the transfers are chained with repeated
+ * starts so the whole batch is one bus transaction. A POLL ends the chain,
+ * the bus is released between polls. The first failure stops the batch.
+ *
+ * @param   Dev       Device Handle
+ * @param   pBatch    The batch
+ * @return  VL53L0X_ERROR_NONE            Success
+ * @return  VL53L0X_ERROR_BUFFER_TOO_SMALL More operations were recorded than
+ * VL53L0X_REG_BATCH_SIZE, nothing was run
+ * @return  VL53L0X_ERROR_TIME_OUT        A POLL never matched
+ * @return  "Other error code"    See ::VL53L0X_Error
+ */
+VL53L0X_Error VL53L0X_batch_submit(VL53L0X_DEV Dev,
+                                   VL53L0X_RegBatch_t *pBatch);
+
 /** @} end of VL53L0X_registerAccess_group */
 
 /**
@@ -238,6 +347,16 @@ VL53L0X_Error VL53L0X_UpdateByte(VL53L0X_DEV Dev, uint8_t index,
 VL53L0X_Error VL53L0X_PollingDelay(
     VL53L0X_DEV Dev); /* usually best implemented as a real function */
 
+/**
+ * @brief Milliseconds since an arbitrary origin, for timeouts that can not
+ * be counted in polling loops
+ *
+ * @param   pTickCountMs  Where to store the tick count, wraps around
+ * @return  VL53L0X_ERROR_NONE        Success
+ * @return  "Other error code"    See ::VL53L0X_Error
+ */
+VL53L0X_Error VL53L0X_GetTickCount(uint32_t *pTickCountMs);
+
 /** @} end of VL53L0X_platform_group */
 
 #ifdef __cplusplus
@@ -45,6 +45,11 @@ extern "C" {
 
 //#define VL53L0X_LOG_ENABLE 0
 
+/* Uncomment, or define for the whole build, to record the call count and
+ * elapsed time of every PAL function instead of printing traces. Ignored
+ * when VL53L0X_LOG_ENABLE is defined. */
+//#define VL53L0X_LATENCY_ENABLE
+
 enum {
   TRACE_LEVEL_NONE,
   TRACE_LEVEL_ERRORS,
@@ -103,6 +108,40 @@ void trace_print_module_function(uint32_t module, uint32_t level,
 //#define VL53L0X_ErrLog( fmt, ...)  fprintf(stderr, "VL53L0X_ErrLog %s" fmt
 //"\n", __func__, ##__VA_ARGS__)
 
+#elif defined(VL53L0X_LATENCY_ENABLE)
+
+#ifndef VL53L0X_LATENCY_TABLE_SIZE
+#define VL53L0X_LATENCY_TABLE_SIZE 48 /*!< Distinct functions recorded */
+#endif
+
+#ifndef VL53L0X_LATENCY_STACK_DEPTH
+#define VL53L0X_LATENCY_STACK_DEPTH 8 /*!< Deepest PAL call nesting timed */
+#endif
+
+/** @brief Time spent in one PAL function, callees included */
+typedef struct {
+  const char *Function;        /*!< __FUNCTION__ of the PAL function */
+  uint32_t Calls;              /*!< Completed calls */
+  uint32_t TotalMicroSeconds;  /*!< Sum of all calls, wraps after ~71 min */
+  uint32_t MinMicroSeconds;    /*!< Shortest call */
+  uint32_t MaxMicroSeconds;    /*!< Longest call */
+} VL53L0X_LatencyEntry_t;
+
+void VL53L0X_latency_start(const char *function);
+void VL53L0X_latency_end(const char *function);
+void VL53L0X_latency_reset(void);
+uint8_t VL53L0X_latency_get_count(void);
+const VL53L0X_LatencyEntry_t *VL53L0X_latency_get_entry(uint8_t index);
+uint32_t VL53L0X_latency_get_dropped(void);
+
+#define VL53L0X_ErrLog(...) (void)0
+#define _LOG_FUNCTION_START(module, fmt, ...)                                  \
+  VL53L0X_latency_start(__FUNCTION__)
+#define _LOG_FUNCTION_END(module, status, ...)                                 \
+  VL53L0X_latency_end(__FUNCTION__)
+#define _LOG_FUNCTION_END_FMT(module, status, fmt, ...)                        \
+  VL53L0X_latency_end(__FUNCTION__)
+
 #else /* VL53L0X_LOG_ENABLE no logging */
 #define VL53L0X_ErrLog(...) (void)0
 #define _LOG_FUNCTION_START(module, fmt, ...) (void)0